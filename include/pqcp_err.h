@@ -43,7 +43,9 @@ typedef enum
     PQCP_COMPOSITE_KEYLEN_ERROR,
     PQCP_COMPOSITE_INVALID_SIG_LEN,
     PQCP_COMPOSITE_KEY_INFO_ALREADY_SET,
-    PQCP_COMPOSITE_LEN_NOT_ENOUGH
+    PQCP_COMPOSITE_LEN_NOT_ENOUGH,
+
+    PQCP_SCLOUDPLUS_PARALLEL_FAIL
 } PQCP_ERROR;
  
 
@@ -16,6 +16,8 @@
 #ifndef PQCP_TYPES_H
 #define PQCP_TYPES_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -54,8 +56,30 @@ typedef enum
     PQCP_CTRL_HYBRID_GET_TRAD_CIPHER_LEN,
     PQCP_CTRL_HYBRID_GET_PQC_SIGNLEN,
     PQCP_CTRL_HYBRID_GET_TRAD_SIGNLEN,
+
+    PQCP_SCLOUDPLUS_SET_MATRIX_A_CACHE,
+    PQCP_SCLOUDPLUS_SET_PARALLEL,
+    PQCP_SCLOUDPLUS_SET_KEYGEN_SEED,
+    PQCP_SCLOUDPLUS_SET_ENCAPS_SEED,
+    PQCP_SCLOUDPLUS_SET_ENCAPS_POOL,
+    PQCP_SCLOUDPLUS_GET_ENCAPS_POOL_NUM,
+    PQCP_SCLOUDPLUS_FILL_ENCAPS_POOL,
 } PQCP_PKEY_CTRL_TYPE;
 
+/*
+ * 并行执行回调：对 idx = 0..taskNum-1 各调用一次 task(arg, idx)，全部任务完成后返回。
+ * 各任务互不依赖，可在任意线程、以任意顺序执行，结果与执行顺序无关；返回非0表示调度失败。
+ */
+typedef void (*PQCP_ParallelTask)(void *arg, uint32_t idx);
+typedef int32_t (*PQCP_ParallelFor)(void *pool, uint32_t taskNum, PQCP_ParallelTask task, void *arg);
+
+// PQCP_SCLOUDPLUS_SET_PARALLEL的参数
+typedef struct {
+    PQCP_ParallelFor parallelFor; // 为NULL时关闭并行
+    void *pool;                   // 原样传给parallelFor
+    uint32_t taskNum;             // 每次矩阵运算划分的任务数
+} PQCP_ParallelCfg;
+
 typedef enum {
     PQCP_SCLOUDPLUS_128 = 6000,
     PQCP_SCLOUDPLUS_192,
@@ -107,6 +107,7 @@ void PQCP_LAC2_FreeCtx(CRYPT_POLAR_LAC_Ctx *ctx)
         BSL_SAL_FREE(ctx->sk);
         BSL_SAL_FREE(ctx->pk);
     }
+    BSL_SAL_CleanseData(ctx->nttS, sizeof(ctx->nttS));
     BSL_SAL_FREE(ctx);
 }
 
@@ -153,6 +154,15 @@ int32_t PQCP_LAC2_SetPrvKey(CRYPT_POLAR_LAC_Ctx *ctx, BSL_Param *param)
     uint32_t useLen = ctx->info->skLen;
     memcpy(ctx->sk, prv->value, useLen);
     memcpy(ctx->pk, ctx->sk + ctx->info->skLen - ctx->info->pkLen, ctx->info->pkLen);
+    int32_t ret = PQCP_POLAR_LAC_PkePreparePk(ctx);
+    if (ret != PQCP_SUCCESS) {
+        BSL_SAL_CleanseData(ctx->sk, ctx->info->skLen);
+        BSL_SAL_FREE(ctx->sk);
+        BSL_SAL_FREE(ctx->pk);
+        return ret;
+    }
+    PQCP_POLAR_LAC_PolyNtt(ctx->sk, ctx->nttS, ctx->algId);
+    ctx->skNttReady = true;
     return PQCP_SUCCESS;
 }
 
@@ -176,7 +186,11 @@ int32_t PQCP_LAC2_SetPubKey(CRYPT_POLAR_LAC_Ctx *ctx, BSL_Param *param)
         return PQCP_MEM_ALLOC_FAIL;
     }
     memcpy(ctx->pk, pub->value, ctx->info->pkLen);
-    return PQCP_SUCCESS;
+    int32_t ret = PQCP_POLAR_LAC_PkePreparePk(ctx);
+    if (ret != PQCP_SUCCESS) {
+        BSL_SAL_FREE(ctx->pk);
+    }
+    return ret;
 }
 
 int32_t PQCP_LAC2_EncapsInit(CRYPT_POLAR_LAC_Ctx *ctx, const BSL_Param *params)
@@ -328,6 +342,15 @@ CRYPT_POLAR_LAC_Ctx *PQCP_LAC2_DupCtx(CRYPT_POLAR_LAC_Ctx *srcCtx)
         }
         memcpy(ctx->pk, srcCtx->pk, srcCtx->info->pkLen);
     }
+    ctx->pkNttReady = srcCtx->pkNttReady;
+    if (srcCtx->pkNttReady) {
+        memcpy(ctx->nttA, srcCtx->nttA, sizeof(ctx->nttA));
+        memcpy(ctx->nttB, srcCtx->nttB, sizeof(ctx->nttB));
+    }
+    ctx->skNttReady = srcCtx->skNttReady;
+    if (srcCtx->skNttReady) {
+        memcpy(ctx->nttS, srcCtx->nttS, sizeof(ctx->nttS));
+    }
     return ctx;
 }
 
@@ -16,6 +16,7 @@
 #ifndef CRYPT_LAC2_LOCAL_H
 #define CRYPT_LAC2_LOCAL_H
 #include <stdint.h>
+#include <stdbool.h>
 #include "pqcp_types.h"
 #include "pqcp_err.h"
 
@@ -24,6 +25,7 @@
 #define q_half  126
 #define neg_one 250
 #define HASHLEN 32
+#define POLAR_LAC_MAX_DIM 1024
 
 #define SHAKE128_RATE 168
 #define SHAKE256_RATE 136
@@ -75,6 +77,11 @@ typedef struct CryptPolarLacCtx {
     uint8_t *sk;
     uint8_t *pk;
     void *libCtx;
+    bool pkNttReady; // nttA and nttB below match pk, set whenever pk is set or generated
+    int16_t nttA[POLAR_LAC_MAX_DIM]; // NTT form of a generated from the seed in pk
+    int16_t nttB[POLAR_LAC_MAX_DIM]; // NTT form of b = pk + seedLen
+    bool skNttReady; // nttS below matches sk, set whenever sk is set or generated
+    int16_t nttS[POLAR_LAC_MAX_DIM]; // NTT form of the secret s, cleansed together with sk
 } CRYPT_POLAR_LAC_Ctx;
 
 // Returns r = a * β^(-1) mod q, where 0 < r < q, mapped to standard representation
@@ -93,13 +100,23 @@ static inline int32_t MontgomeryMapFull(int32_t a)
 
 // Polar encode and decode functions
 void PQCP_POLAR_LAC_EncodePolar(uint8_t *u, int32_t algId);
-void PQCP_POLAR_LAC_DecodePolar(uint8_t *mCap, const float *llr, int32_t algId);
+void PQCP_POLAR_LAC_DecodePolar(uint8_t *mCap, const int16_t *llr, int32_t algId);
+// check the pruned decoding tree of algId against its frozen bit pattern, PQCP_SUCCESS if it is consistent
+int32_t PQCP_POLAR_LAC_CheckPolarNodes(int32_t algId);
 
 // Poly functions
 // PQCP_POLAR_LAC_PolyMul  b=[as]
 void PQCP_POLAR_LAC_PolyMul(const uint8_t *a, const uint8_t *s, uint8_t *b, uint32_t vecNum, int32_t algId);
 // PQCP_POLAR_LAC_PolyAff  b=as+e
 void PQCP_POLAR_LAC_PolyAff(const uint8_t *a, const uint8_t *s, uint8_t *e, uint8_t *b, uint32_t vecNum, int32_t algId);
+// NTT-domain variants: aHat/sHat come from PQCP_POLAR_LAC_PolyNtt, so a fixed operand is transformed only once
+void PQCP_POLAR_LAC_PolyNtt(const uint8_t *a, int16_t *aHat, int32_t algId);
+void PQCP_POLAR_LAC_PolyMulNtt(const int16_t *aHat, const int16_t *sHat, uint8_t *b, uint32_t vecNum, int32_t algId);
+void PQCP_POLAR_LAC_PolyAffNtt(const int16_t *aHat, const int16_t *sHat, const uint8_t *e, uint8_t *b, uint32_t vecNum,
+                               int32_t algId);
+// multi-product PolyAff: b[k]=a[k]s+e[k], k < num, with a single forward NTT of the shared s
+void PQCP_POLAR_LAC_PolyAffMulti(const uint8_t *s, const uint8_t *const *a, const uint8_t *const *e, uint8_t *const *b,
+                                 const uint32_t *vecNum, uint32_t num, int32_t algId);
 int32_t PQCP_POLAR_LAC_PolyCompress(const uint8_t *in, uint8_t *out, const uint32_t vecNum, const uint32_t bits);
 int32_t PQCP_POLAR_LAC_PolyDecompress(const uint8_t *in, uint8_t *out, const uint32_t vecNum, const uint32_t bits);
 
@@ -108,6 +125,15 @@ void PQCP_PQCP_POLAR_LAC_NttLazy1024(int16_t *a);
 void PQCP_PQCP_POLAR_LAC_InttLazy1024(int16_t *a);
 void PQCP_POLAR_LAC_NttLazy(int16_t *a);
 void PQCP_POLAR_LAC_InttLazy(int16_t *a);
+// Vectorized transforms, selected at compile time like the other vector kernels of the provider.
+// zetas is the twiddle table of the scalar transform and scale the final factor N^(-1)*β; results are bit-identical.
+// There is no runtime CPU detection: an x86 build only gets the AVX2 transform when compiled with -mavx2 (or a
+// -march that implies it), generic -march=x86-64 builds always use the scalar NTT.
+#if defined(__AVX2__) || defined(__ARM_NEON)
+#define POLAR_LAC_NTT_SIMD
+void PQCP_POLAR_LAC_NttLazySimd(int16_t *a, const int16_t *zetas, int32_t n);
+void PQCP_POLAR_LAC_InttLazySimd(int16_t *a, const int16_t *zetas, int32_t n, int32_t scale);
+#endif
 
 // KEM functions
 int32_t PQCP_POLAR_LAC_KeyGenInternal(CRYPT_POLAR_LAC_Ctx *ctx);
@@ -120,6 +146,8 @@ int32_t PQCP_POLAR_LAC_PkeEncrypt(const CRYPT_POLAR_LAC_Ctx *ctx, const uint8_t
 int32_t PQCP_POLAR_LAC_PkeDecrypt(const CRYPT_POLAR_LAC_Ctx *ctx, const uint8_t *c, uint32_t clen, uint8_t *m,
                             uint32_t *mlen);
 int32_t PQCP_POLAR_LAC_PkeKeyGen(CRYPT_POLAR_LAC_Ctx *ctx, uint8_t *seed);
+// compute nttA and nttB of ctx from ctx->pk
+int32_t PQCP_POLAR_LAC_PkePreparePk(CRYPT_POLAR_LAC_Ctx *ctx);
 
 // Sampling functions
 int32_t PQCP_POLAR_LAC_PseudoRandomBytes(void *libCtx, const uint8_t *in, uint32_t inLen, uint8_t *out, uint32_t outLen);
@@ -109,6 +109,9 @@ static int16_t Mn[512] = {
  */
 void PQCP_POLAR_LAC_NttLazy(int16_t *a)
 {
+#ifdef POLAR_LAC_NTT_SIMD
+    PQCP_POLAR_LAC_NttLazySimd(a, M, POLAR_LAC_LIGHT_128_DIM);
+#else
     int32_t t; // Step size, distance between elements in butterfly operations
     int32_t m; // Current stage number in NTT
     int32_t i; // Index for iterating over blocks at current stage
@@ -190,6 +193,7 @@ void PQCP_POLAR_LAC_NttLazy(int16_t *a)
             a[j + t] = a[j + t] + ((a[j + t] >> 15) & NTTQ);
         }
     }
+#endif // POLAR_LAC_NTT_SIMD
 }
 
 /**
@@ -218,6 +222,9 @@ void PQCP_POLAR_LAC_NttLazy(int16_t *a)
  */
 void PQCP_POLAR_LAC_InttLazy(int16_t *a)
 {
+#ifdef POLAR_LAC_NTT_SIMD
+    PQCP_POLAR_LAC_InttLazySimd(a, Mn, POLAR_LAC_LIGHT_128_DIM, INVERSE_N_BETA);
+#else
     int32_t t; // Step size, starting from 1 and doubling at each stage
     int32_t m; // Current stage size in INTT
     int32_t i; // Index for iterating over half stages
@@ -259,5 +266,6 @@ void PQCP_POLAR_LAC_InttLazy(int16_t *a)
     for (i = 0; i < POLAR_LAC_LIGHT_128_DIM; i++) {
         a[i] = (a[i] * INVERSE_N_BETA) % NTTQ;
     }
+#endif // POLAR_LAC_NTT_SIMD
 }
 #endif // PQCP_POLARLAC
@@ -29,7 +29,7 @@
 #define POLAR_LAC_256_DIM 1024
 
 // twiddle factors for 1024 length in NTT use Montgomery
-const int32_t M_1024[1024] = {
+static const int16_t M_1024[1024] = {
     10237, 1356,  4658,  6948,  8459,  2028,  9087,  11370, 17111, 11095, 6113,  16558, 12704, 2891,  1965,
     4047,  8745,  8161,  765,   872,   2802,  14326, 18109, 3751,  1532,  14806, 16006, 1643,  16483, 1753,
     13172, 17954, 14691, 3156,  1380,  17476, 2886,  9940,  4837,  14718, 16498, 7553,  10802, 4771,  6241,
@@ -100,7 +100,7 @@ const int32_t M_1024[1024] = {
     9560,  8806,  1026,  4294,  7521,  3569,  9827,  6422,  7007,  17572, 17307, 13629, 16475, 3279,  14436,
     12227, 2781,  3599,  2994}; // Pre-computed positive powers of primitive roots for Montgomery multiplication
 
-const int32_t Mn_1024[1024] = {
+static const int16_t Mn_1024[1024] = {
     10237, 17077, 11485, 13775, 7063,  9346,  16405, 9974,  14386, 16468, 15542, 5729,  1875,  12320, 7338,  1322,
     479,   5261,  16680, 1950,  16790, 2427,  3627,  16901, 14682, 324,   4107,  15631, 17561, 17668, 10272, 9688,
     14491, 12734, 15658, 3886,  91,    13968, 5016,  14378, 16554, 13804, 12495, 16479, 13141, 177,   8900,  11782,
@@ -168,6 +168,9 @@ const int32_t Mn_1024[1024] = {
 
 void PQCP_PQCP_POLAR_LAC_NttLazy1024(int16_t *a)
 {
+#ifdef POLAR_LAC_NTT_SIMD
+    PQCP_POLAR_LAC_NttLazySimd(a, M_1024, POLAR_LAC_256_DIM);
+#else
     int32_t t; // Step size, distance between elements in butterfly operations
     int32_t m; // Current stage number in NTT
     int32_t i; // Index for iterating over blocks at current stage
@@ -236,10 +239,14 @@ void PQCP_PQCP_POLAR_LAC_NttLazy1024(int16_t *a)
             a[j + t] = a[j + t] + ((a[j + t] >> 15) & NTTQ);
         }
     }
+#endif // POLAR_LAC_NTT_SIMD
 }
 
 void PQCP_PQCP_POLAR_LAC_InttLazy1024(int16_t *a)
 {
+#ifdef POLAR_LAC_NTT_SIMD
+    PQCP_POLAR_LAC_InttLazySimd(a, Mn_1024, POLAR_LAC_256_DIM, INVERSE_N_BETA);
+#else
     int32_t t; // Step size, starting from 1 and doubling at each stage
     int32_t m; // Current stage size in INTT
     int32_t i; // Index for iterating over half stages
@@ -272,5 +279,6 @@ void PQCP_PQCP_POLAR_LAC_InttLazy1024(int16_t *a)
     for (i = 0; i < POLAR_LAC_256_DIM; i++) {
         a[i] = (a[i] * INVERSE_N_BETA) % NTTQ;
     }
+#endif // POLAR_LAC_NTT_SIMD
 }
 #endif // PQCP_POLARLAC
\ No newline at end of file
@@ -0,0 +1,612 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+
+// This file implements the vectorized lazy NTT and INTT shared by the 512 and 1024 point transforms.
+// Every lane performs exactly the same int16/int32 arithmetic as the scalar butterflies in ntt.c,
+// so the results are bit-identical to the scalar code.
+#ifdef PQCP_POLARLAC
+#include <stdint.h>
+#include "polarlac_local.h"
+
+#ifdef POLAR_LAC_NTT_SIMD
+
+// Which reductions the forward butterfly applies, see the three levels of PQCP_POLAR_LAC_NttLazy
+typedef enum {
+    NTT_LEVEL_FIRST, // inputs in (0, NTTQ), no reduction
+    NTT_LEVEL_MIDDLE, // reduce u
+    NTT_LEVEL_LAST // reduce u and both outputs
+} NttLevel;
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+#define NTT_LANES 16
+
+typedef __m256i NttVec;
+typedef struct {
+    __m256i w;
+    __m256i wq; // w * INVERSE_Q mod 2^16
+} NttTw;
+
+static inline NttVec NttLoad(const int16_t *p)
+{
+    return _mm256_loadu_si256((const __m256i *)p);
+}
+
+static inline void NttStore(int16_t *p, NttVec x)
+{
+    _mm256_storeu_si256((__m256i *)p, x);
+}
+
+static inline NttVec NttBroadcast(int16_t w)
+{
+    return _mm256_set1_epi16(w);
+}
+
+// x + ((x >> 15) & NTTQ) on 16-bit lanes
+static inline __m256i NttReduce16(__m256i x)
+{
+    return _mm256_add_epi16(x, _mm256_and_si256(_mm256_srai_epi16(x, 15), _mm256_set1_epi16(NTTQ)));
+}
+
+static inline NttTw NttTwiddle(NttVec w)
+{
+    NttTw tw = {w, _mm256_mullo_epi16(w, _mm256_set1_epi16(INVERSE_Q))};
+    return tw;
+}
+
+/*
+ * MontgomeryMapFull(a) for a = x * tw + 2^16 * hiFix, computed on 16-bit lanes. The low 16 bits of m are
+ * mullo(x, tw * INVERSE_Q), and since they make a - m * NTTQ a multiple of 2^16, (a - m * NTTQ) >> 16 is the
+ * difference of the high halves, which always fits 16 bits (the scalar code keeps the wrapped int32 value).
+ */
+static inline __m256i NttMontMul16(__m256i x, NttTw tw, __m256i hiFix)
+{
+    __m256i m = _mm256_mullo_epi16(x, tw.wq);
+    __m256i r = _mm256_add_epi16(_mm256_mulhi_epi16(x, tw.w), hiFix);
+    return NttReduce16(_mm256_sub_epi16(r, _mm256_mulhi_epu16(m, _mm256_set1_epi16(NTTQ))));
+}
+
+// Truncate two vectors of 8 int32 lanes to one vector of 16 int16 lanes, keeping the lane order
+static inline __m256i NttNarrow32(__m256i lo, __m256i hi)
+{
+    const __m256i mask = _mm256_set1_epi32(0xFFFF);
+    __m256i r = _mm256_packus_epi32(_mm256_and_si256(lo, mask), _mm256_and_si256(hi, mask));
+    return _mm256_permute4x64_epi64(r, 0xD8);
+}
+
+static inline void NttFwdButterfly(NttVec *u, NttVec *v, NttTw tw, NttLevel level)
+{
+    const __m256i q = _mm256_set1_epi16(NTTQ);
+    __m256i x = *u;
+    __m256i y = NttMontMul16(*v, tw, _mm256_setzero_si256());
+    if (level != NTT_LEVEL_FIRST) {
+        x = NttReduce16(x);
+    }
+    *u = _mm256_sub_epi16(_mm256_add_epi16(x, y), q);
+    *v = _mm256_sub_epi16(x, y);
+    if (level == NTT_LEVEL_LAST) {
+        *u = NttReduce16(*u);
+        *v = NttReduce16(*v);
+    }
+}
+
+// u - v may leave the int16 range: with d = u - v wrapped to 16 bits, (u - v) * tw = d * tw + 2^16 * c * tw,
+// where c = +1/-1 when the subtraction overflows towards the sign of u
+static inline void NttInvButterfly(NttVec *u, NttVec *v, NttTw tw)
+{
+    const __m256i q = _mm256_set1_epi16(NTTQ);
+    __m256i x = *u;
+    __m256i y = *v;
+    __m256i d = _mm256_sub_epi16(x, y);
+    __m256i overflow = _mm256_srai_epi16(_mm256_and_si256(_mm256_xor_si256(x, y), _mm256_xor_si256(x, d)), 15);
+    *u = NttReduce16(_mm256_sub_epi16(_mm256_add_epi16(x, y), q));
+    *v = NttMontMul16(d, tw, _mm256_and_si256(overflow, _mm256_sign_epi16(tw.w, x)));
+}
+
+/*
+ * Exchange lanes of a 32-coefficient chunk (a, b) so that elements t apart in the current layout face each other.
+ * Applying t = 8, 4, 2, 1 in turn to a chunk in coefficient order lines up the butterfly pairs of each level
+ * with the blocks in ascending lane order. Every shuffle is its own inverse, so the reverse sequence restores the order.
+ */
+static inline void NttShuffle(NttVec *a, NttVec *b, int32_t t)
+{
+    __m256i x = *a;
+    __m256i y = *b;
+    switch (t) {
+        case 8:
+            *a = _mm256_permute2x128_si256(x, y, 0x20);
+            *b = _mm256_permute2x128_si256(x, y, 0x31);
+            break;
+        case 4:
+            *a = _mm256_unpacklo_epi64(x, y);
+            *b = _mm256_unpackhi_epi64(x, y);
+            break;
+        case 2:
+            *a = _mm256_blend_epi32(x, _mm256_slli_epi64(y, 32), 0xAA);
+            *b = _mm256_blend_epi32(_mm256_srli_epi64(x, 32), y, 0xAA);
+            break;
+        default:
+            *a = _mm256_blend_epi16(x, _mm256_slli_epi32(y, 16), 0xAA);
+            *b = _mm256_blend_epi16(_mm256_srli_epi32(x, 16), y, 0xAA);
+            break;
+    }
+}
+
+// Twiddle factors of the 16 / t consecutive blocks w[0], w[1], ..., each repeated t times as laid out by NttShuffle
+static inline NttVec NttTwiddles(const int16_t *w, int32_t t)
+{
+    __m128i x;
+    switch (t) {
+        case 8:
+            return _mm256_setr_m128i(_mm_set1_epi16(w[0]), _mm_set1_epi16(w[1]));
+        case 4:
+            x = _mm_loadl_epi64((const __m128i *)w);
+            x = _mm_unpacklo_epi16(x, x);
+            return _mm256_setr_m128i(_mm_unpacklo_epi32(x, x), _mm_unpackhi_epi32(x, x));
+        case 2:
+            x = _mm_loadu_si128((const __m128i *)w);
+            return _mm256_setr_m128i(_mm_unpacklo_epi16(x, x), _mm_unpackhi_epi16(x, x));
+        default:
+            return _mm256_loadu_si256((const __m256i *)w);
+    }
+}
+
+// (x * scale) % NTTQ with the C remainder sign, on 32-bit lanes. |x * scale| < 2^24 is exact in float,
+// and the quotient estimate is off by at most one, which the two corrections remove.
+static inline __m256i NttScale32(__m256i x, int32_t scale)
+{
+    const __m256i q = _mm256_set1_epi32(NTTQ);
+    __m256i p = _mm256_mullo_epi32(x, _mm256_set1_epi32(scale));
+    __m256i r = _mm256_abs_epi32(p);
+    __m256 f = _mm256_mul_ps(_mm256_cvtepi32_ps(r), _mm256_set1_ps(1.0f / NTTQ));
+    r = _mm256_sub_epi32(r, _mm256_mullo_epi32(_mm256_cvttps_epi32(f), q));
+    r = _mm256_add_epi32(r, _mm256_and_si256(_mm256_srai_epi32(r, 31), q));
+    r = _mm256_sub_epi32(r, _mm256_and_si256(_mm256_cmpgt_epi32(r, _mm256_set1_epi32(NTTQ - 1)), q));
+    return _mm256_sign_epi32(r, p);
+}
+
+static inline NttVec NttScale(NttVec x, int32_t scale)
+{
+    return NttNarrow32(NttScale32(_mm256_cvtepi16_epi32(_mm256_castsi256_si128(x)), scale),
+                       NttScale32(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(x, 1)), scale));
+}
+
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+
+#define NTT_LANES 8
+
+typedef int16x8_t NttVec;
+typedef struct {
+    int16x8_t w;
+    int16x8_t wq; // w * INVERSE_Q mod 2^16
+} NttTw;
+
+static inline NttVec NttLoad(const int16_t *p)
+{
+    return vld1q_s16(p);
+}
+
+static inline void NttStore(int16_t *p, NttVec x)
+{
+    vst1q_s16(p, x);
+}
+
+static inline NttVec NttBroadcast(int16_t w)
+{
+    return vdupq_n_s16(w);
+}
+
+static inline NttTw NttTwiddle(NttVec w)
+{
+    NttTw tw = {w, vmulq_s16(w, vdupq_n_s16(INVERSE_Q))};
+    return tw;
+}
+
+// x + ((x >> 15) & NTTQ) on 16-bit lanes
+static inline int16x8_t NttReduce16(int16x8_t x)
+{
+    return vaddq_s16(x, vandq_s16(vshrq_n_s16(x, 15), vdupq_n_s16(NTTQ)));
+}
+
+// MontgomeryMapFull(x * tw + 2^16 * hiFix) on 16-bit lanes as in the AVX2 version. vqdmulh returns the doubled
+// high halves, which never saturate since tw and NTTQ are positive, and vhsub halves their exact difference.
+static inline int16x8_t NttMontMul16(int16x8_t x, NttTw tw, int16x8_t hiFix)
+{
+    const int16x8_t q = vdupq_n_s16(NTTQ);
+    int16x8_t m = vmulq_s16(x, tw.wq);
+    int16x8_t r = vhsubq_s16(vqdmulhq_s16(x, tw.w), vqdmulhq_s16(m, q));
+    // m is taken as unsigned in the scalar code
+    r = vsubq_s16(vaddq_s16(r, hiFix), vandq_s16(vshrq_n_s16(m, 15), q));
+    return NttReduce16(r);
+}
+
+// Truncate two vectors of 4 int32 lanes to one vector of 8 int16 lanes
+static inline int16x8_t NttNarrow32(int32x4_t lo, int32x4_t hi)
+{
+    return vcombine_s16(vmovn_s32(lo), vmovn_s32(hi));
+}
+
+static inline void NttFwdButterfly(NttVec *u, NttVec *v, NttTw tw, NttLevel level)
+{
+    const int16x8_t q = vdupq_n_s16(NTTQ);
+    int16x8_t x = *u;
+    int16x8_t y = NttMontMul16(*v, tw, vdupq_n_s16(0));
+    if (level != NTT_LEVEL_FIRST) {
+        x = NttReduce16(x);
+    }
+    *u = vsubq_s16(vaddq_s16(x, y), q);
+    *v = vsubq_s16(x, y);
+    if (level == NTT_LEVEL_LAST) {
+        *u = NttReduce16(*u);
+        *v = NttReduce16(*v);
+    }
+}
+
+// See the AVX2 version for the 16-bit overflow correction of u - v
+static inline void NttInvButterfly(NttVec *u, NttVec *v, NttTw tw)
+{
+    const int16x8_t q = vdupq_n_s16(NTTQ);
+    int16x8_t x = *u;
+    int16x8_t y = *v;
+    int16x8_t d = vsubq_s16(x, y);
+    int16x8_t overflow = vshrq_n_s16(vandq_s16(veorq_s16(x, y), veorq_s16(x, d)), 15);
+    int16x8_t sign = vshrq_n_s16(x, 15);
+    int16x8_t hiFix = vandq_s16(overflow, vsubq_s16(veorq_s16(tw.w, sign), sign));
+    *u = NttReduce16(vsubq_s16(vaddq_s16(x, y), q));
+    *v = NttMontMul16(d, tw, hiFix);
+}
+
+// Exchange lanes of a 16-coefficient chunk (a, b) as in the AVX2 version, for t = 4, 2, 1
+static inline void NttShuffle(NttVec *a, NttVec *b, int32_t t)
+{
+    int16x8_t x = *a;
+    int16x8_t y = *b;
+    int32x4x2_t r32;
+    int16x8x2_t r16;
+    switch (t) {
+        case 4:
+            *a = vcombine_s16(vget_low_s16(x), vget_low_s16(y));
+            *b = vcombine_s16(vget_high_s16(x), vget_high_s16(y));
+            break;
+        case 2:
+            r32 = vtrnq_s32(vreinterpretq_s32_s16(x), vreinterpretq_s32_s16(y));
+            *a = vreinterpretq_s16_s32(r32.val[0]);
+            *b = vreinterpretq_s16_s32(r32.val[1]);
+            break;
+        default:
+            r16 = vtrnq_s16(x, y);
+            *a = r16.val[0];
+            *b = r16.val[1];
+            break;
+    }
+}
+
+// Twiddle factors of the 8 / t consecutive blocks w[0], w[1], ..., each repeated t times as laid out by NttShuffle
+static inline NttVec NttTwiddles(const int16_t *w, int32_t t)
+{
+    int16x4x2_t x;
+    switch (t) {
+        case 4:
+            return vcombine_s16(vdup_n_s16(w[0]), vdup_n_s16(w[1]));
+        case 2:
+            x = vzip_s16(vld1_s16(w), vld1_s16(w));
+            return vcombine_s16(x.val[0], x.val[1]);
+        default:
+            return vld1q_s16(w);
+    }
+}
+
+// (x * scale) % NTTQ with the C remainder sign, on 32-bit lanes. |x * scale| < 2^24 is exact in float,
+// and the quotient estimate is off by at most one, which the two corrections remove.
+static inline int32x4_t NttScale32(int32x4_t x, int32_t scale)
+{
+    const int32x4_t q = vdupq_n_s32(NTTQ);
+    int32x4_t p = vmulq_n_s32(x, scale);
+    int32x4_t sign = vshrq_n_s32(p, 31);
+    int32x4_t r = vabsq_s32(p);
+    int32x4_t k = vcvtq_s32_f32(vmulq_n_f32(vcvtq_f32_s32(r), 1.0f / NTTQ));
+    r = vmlsq_n_s32(r, k, NTTQ);
+    r = vaddq_s32(r, vandq_s32(vshrq_n_s32(r, 31), q));
+    r = vsubq_s32(r, vandq_s32(vreinterpretq_s32_u32(vcgeq_s32(r, q)), q));
+    return vsubq_s32(veorq_s32(r, sign), sign);
+}
+
+static inline NttVec NttScale(NttVec x, int32_t scale)
+{
+    return NttNarrow32(NttScale32(vmovl_s16(vget_low_s16(x)), scale), NttScale32(vmovl_s16(vget_high_s16(x)), scale));
+}
+#endif
+
+#define NTT_MERGE_MAX 3 // levels merged into one pass, the 2^3 vectors of a column stay in registers
+
+// The helpers below are spelled out for every count, since loops over the column would keep it in memory.
+// cnt twiddles z[0 .. cnt - 1], cnt <= 4
+__attribute__((always_inline)) static inline void NttGather(NttTw *w, const int16_t *z, int32_t cnt)
+{
+    w[0] = NttTwiddle(NttBroadcast(z[0]));
+    if (cnt > 1) {
+        w[1] = NttTwiddle(NttBroadcast(z[1]));
+    }
+    if (cnt > 2) {
+        w[2] = NttTwiddle(NttBroadcast(z[2]));
+        w[3] = NttTwiddle(NttBroadcast(z[3]));
+    }
+}
+
+// Column of 2^k vectors p[0], p[s], ..., p[(2^k - 1) * s]
+__attribute__((always_inline)) static inline void NttLoadColumn(NttVec *x, const int16_t *p, int32_t s, int32_t k)
+{
+    x[0] = NttLoad(p);
+    x[1] = NttLoad(p + s);
+    if (k > 1) {
+        x[2] = NttLoad(p + 2 * s);
+        x[3] = NttLoad(p + 3 * s);
+    }
+    if (k > 2) {
+        x[4] = NttLoad(p + 4 * s);
+        x[5] = NttLoad(p + 5 * s);
+        x[6] = NttLoad(p + 6 * s);
+        x[7] = NttLoad(p + 7 * s);
+    }
+}
+
+__attribute__((always_inline)) static inline void NttStoreColumn(int16_t *p, int32_t s, const NttVec *x, int32_t k)
+{
+    NttStore(p, x[0]);
+    NttStore(p + s, x[1]);
+    if (k > 1) {
+        NttStore(p + 2 * s, x[2]);
+        NttStore(p + 3 * s, x[3]);
+    }
+    if (k > 2) {
+        NttStore(p + 4 * s, x[4]);
+        NttStore(p + 5 * s, x[5]);
+        NttStore(p + 6 * s, x[6]);
+        NttStore(p + 7 * s, x[7]);
+    }
+}
+
+/*
+ * Butterflies of k merged forward levels on a column x[0 .. 2^k - 1] of vectors, level l pairing vectors
+ * 2^(k - 1 - l) apart. w holds the twiddles in the order they are consumed: 1 for level 0, 2 for level 1, 4 for level 2.
+ */
+__attribute__((always_inline)) static inline void NttFwdColumn(NttVec *x, const NttTw *w, int32_t k,
+                                                               NttLevel level0)
+{
+    if (k == 1) {
+        NttFwdButterfly(&x[0], &x[1], w[0], level0);
+    } else if (k == 2) {
+        NttFwdButterfly(&x[0], &x[2], w[0], level0);
+        NttFwdButterfly(&x[1], &x[3], w[0], level0);
+        NttFwdButterfly(&x[0], &x[1], w[1], NTT_LEVEL_MIDDLE);
+        NttFwdButterfly(&x[2], &x[3], w[2], NTT_LEVEL_MIDDLE);
+    } else {
+        NttFwdButterfly(&x[0], &x[4], w[0], level0);
+        NttFwdButterfly(&x[1], &x[5], w[0], level0);
+        NttFwdButterfly(&x[2], &x[6], w[0], level0);
+        NttFwdButterfly(&x[3], &x[7], w[0], level0);
+        NttFwdButterfly(&x[0], &x[2], w[1], NTT_LEVEL_MIDDLE);
+        NttFwdButterfly(&x[1], &x[3], w[1], NTT_LEVEL_MIDDLE);
+        NttFwdButterfly(&x[4], &x[6], w[2], NTT_LEVEL_MIDDLE);
+        NttFwdButterfly(&x[5], &x[7], w[2], NTT_LEVEL_MIDDLE);
+        NttFwdButterfly(&x[0], &x[1], w[3], NTT_LEVEL_MIDDLE);
+        NttFwdButterfly(&x[2], &x[3], w[4], NTT_LEVEL_MIDDLE);
+        NttFwdButterfly(&x[4], &x[5], w[5], NTT_LEVEL_MIDDLE);
+        NttFwdButterfly(&x[6], &x[7], w[6], NTT_LEVEL_MIDDLE);
+    }
+}
+
+/*
+ * Forward levels t = top, top / 2, ..., top >> (k - 1), all with t >= NTT_LANES, in a single pass over a.
+ * Each block of 2 * top coefficients is processed as columns of 2^k vectors spaced top >> (k - 1) apart,
+ * and the 2^k - 1 twiddles of the block are gathered once in access order.
+ */
+__attribute__((always_inline)) static inline void NttFwdMerged(int16_t *a, const int16_t *zetas, int32_t n,
+                                                               int32_t top, int32_t k, NttLevel level0)
+{
+    const int32_t s = top >> (k - 1);
+    NttTw w[(1 << NTT_MERGE_MAX) - 1];
+    NttVec x[1 << NTT_MERGE_MAX];
+    int32_t blk, j, l;
+
+    for (blk = 0; blk < n; blk += 2 * top) {
+        // level l has (n / (2 * top)) << l blocks, the current block is split into 2^l of them
+        for (l = 0; l < k; l++) {
+            NttGather(w + (1 << l) - 1, zetas + (((n + blk) / (2 * top)) << l), 1 << l);
+        }
+        for (j = blk; j < blk + s; j += NTT_LANES) {
+            NttLoadColumn(x, a + j, s, k);
+            NttFwdColumn(x, w, k, level0);
+            NttStoreColumn(a + j, s, x, k);
+        }
+    }
+}
+
+// Forward level t < NTT_LANES on the chunk of two vectors starting at coefficient j, which holds NTT_LANES / t blocks
+__attribute__((always_inline)) static inline void NttFwdChunk(NttVec *u, NttVec *v, const int16_t *zetas, int32_t n,
+                                                              int32_t j, int32_t t)
+{
+    NttTw w = NttTwiddle(NttTwiddles(zetas + (n + j) / (2 * t), t));
+    NttShuffle(u, v, t);
+    NttFwdButterfly(u, v, w, (t == 1) ? NTT_LEVEL_LAST : NTT_LEVEL_MIDDLE);
+}
+
+/*
+ * Forward levels t = NTT_LANES / 2, ..., 1 in a single pass, without leaving registers. The twiddles of every
+ * level are consecutive entries of zetas in the chained layout of NttShuffle, which is undone before storing.
+ */
+static void NttFwdInRegister(int16_t *a, const int16_t *zetas, int32_t n)
+{
+    int32_t j;
+    NttVec u;
+    NttVec v;
+
+    for (j = 0; j < n; j += 2 * NTT_LANES) {
+        u = NttLoad(a + j);
+        v = NttLoad(a + j + NTT_LANES);
+#if NTT_LANES == 16
+        NttFwdChunk(&u, &v, zetas, n, j, 8);
+#endif
+        NttFwdChunk(&u, &v, zetas, n, j, 4);
+        NttFwdChunk(&u, &v, zetas, n, j, 2);
+        NttFwdChunk(&u, &v, zetas, n, j, 1);
+        NttShuffle(&u, &v, 1);
+        NttShuffle(&u, &v, 2);
+        NttShuffle(&u, &v, 4);
+#if NTT_LANES == 16
+        NttShuffle(&u, &v, 8);
+#endif
+        NttStore(a + j, u);
+        NttStore(a + j + NTT_LANES, v);
+    }
+}
+
+// Butterflies of k merged inverse levels on a column, level l pairing vectors 2^l apart; w as in NttFwdColumn
+__attribute__((always_inline)) static inline void NttInvColumn(NttVec *x, const NttTw *w, int32_t k)
+{
+    if (k == 1) {
+        NttInvButterfly(&x[0], &x[1], w[0]);
+    } else if (k == 2) {
+        NttInvButterfly(&x[0], &x[1], w[0]);
+        NttInvButterfly(&x[2], &x[3], w[1]);
+        NttInvButterfly(&x[0], &x[2], w[2]);
+        NttInvButterfly(&x[1], &x[3], w[2]);
+    } else {
+        NttInvButterfly(&x[0], &x[1], w[0]);
+        NttInvButterfly(&x[2], &x[3], w[1]);
+        NttInvButterfly(&x[4], &x[5], w[2]);
+        NttInvButterfly(&x[6], &x[7], w[3]);
+        NttInvButterfly(&x[0], &x[2], w[4]);
+        NttInvButterfly(&x[1], &x[3], w[4]);
+        NttInvButterfly(&x[4], &x[6], w[5]);
+        NttInvButterfly(&x[5], &x[7], w[5]);
+        NttInvButterfly(&x[0], &x[4], w[6]);
+        NttInvButterfly(&x[1], &x[5], w[6]);
+        NttInvButterfly(&x[2], &x[6], w[6]);
+        NttInvButterfly(&x[3], &x[7], w[6]);
+    }
+}
+
+/*
+ * Inverse levels t = bottom, 2 * bottom, ..., bottom << (k - 1), all with t >= NTT_LANES, in a single pass over a.
+ * A non-zero scale multiplies the results by scale mod NTTQ before they are stored, as the end of the INTT does.
+ */
+__attribute__((always_inline)) static inline void NttInvMerged(int16_t *a, const int16_t *zetas, int32_t n,
+                                                               int32_t bottom, int32_t k, int32_t scale)
+{
+    NttTw w[(1 << NTT_MERGE_MAX) - 1];
+    NttVec x[1 << NTT_MERGE_MAX];
+    int32_t blk, j, l, r;
+
+    for (blk = 0; blk < n; blk += bottom << k) {
+        // level t = bottom << l has n / (2 * t) blocks, 2^(k - 1 - l) of them lie in the current block
+        for (l = 0; l < k; l++) {
+            NttGather(w + (1 << k) - (1 << (k - l)), zetas + (n + blk) / (2 * (bottom << l)), 1 << (k - 1 - l));
+        }
+        for (j = blk; j < blk + bottom; j += NTT_LANES) {
+            NttLoadColumn(x, a + j, bottom, k);
+            NttInvColumn(x, w, k);
+            if (scale != 0) {
+                for (r = 0; r < (1 << k); r++) {
+                    x[r] = NttScale(x[r], scale);
+                }
+            }
+            NttStoreColumn(a + j, bottom, x, k);
+        }
+    }
+}
+
+// Inverse level t < NTT_LANES on a chunk in the chained layout of level t, which is then left for level 2 * t
+__attribute__((always_inline)) static inline void NttInvChunk(NttVec *u, NttVec *v, const int16_t *zetas, int32_t n,
+                                                              int32_t j, int32_t t)
+{
+    NttTw w = NttTwiddle(NttTwiddles(zetas + (n + j) / (2 * t), t));
+    NttInvButterfly(u, v, w);
+    NttShuffle(u, v, t);
+}
+
+// Inverse levels t = 1, ..., NTT_LANES / 2 in a single pass, walking the layouts of NttFwdInRegister backwards
+static void NttInvInRegister(int16_t *a, const int16_t *zetas, int32_t n)
+{
+    int32_t j;
+    NttVec u;
+    NttVec v;
+
+    for (j = 0; j < n; j += 2 * NTT_LANES) {
+        u = NttLoad(a + j);
+        v = NttLoad(a + j + NTT_LANES);
+#if NTT_LANES == 16
+        NttShuffle(&u, &v, 8);
+#endif
+        NttShuffle(&u, &v, 4);
+        NttShuffle(&u, &v, 2);
+        NttShuffle(&u, &v, 1);
+        NttInvChunk(&u, &v, zetas, n, j, 1);
+        NttInvChunk(&u, &v, zetas, n, j, 2);
+        NttInvChunk(&u, &v, zetas, n, j, 4);
+#if NTT_LANES == 16
+        NttInvChunk(&u, &v, zetas, n, j, 8);
+#endif
+        NttStore(a + j, u);
+        NttStore(a + j + NTT_LANES, v);
+    }
+}
+
+// The 1024-point transform takes three passes over a with AVX2 (levels 512..128, 64..16, 8..1) and four with NEON.
+void PQCP_POLAR_LAC_NttLazySimd(int16_t *a, const int16_t *zetas, int32_t n)
+{
+    int32_t top;
+    int32_t k;
+
+    // the first pass starts at t = n / 2, whose inputs need no reduction; constant level counts keep columns in registers
+    NttFwdMerged(a, zetas, n, n >> 1, NTT_MERGE_MAX, NTT_LEVEL_FIRST);
+    for (top = n >> (NTT_MERGE_MAX + 1); top >= NTT_LANES; top >>= k) {
+        for (k = 1; k < NTT_MERGE_MAX && (top >> k) >= NTT_LANES; k++) {
+        }
+        if (k == 3) {
+            NttFwdMerged(a, zetas, n, top, 3, NTT_LEVEL_MIDDLE);
+        } else if (k == 2) {
+            NttFwdMerged(a, zetas, n, top, 2, NTT_LEVEL_MIDDLE);
+        } else {
+            NttFwdMerged(a, zetas, n, top, 1, NTT_LEVEL_MIDDLE);
+        }
+    }
+    NttFwdInRegister(a, zetas, n);
+}
+
+void PQCP_POLAR_LAC_InttLazySimd(int16_t *a, const int16_t *zetas, int32_t n, int32_t scale)
+{
+    int32_t bottom;
+    int32_t k;
+
+    NttInvInRegister(a, zetas, n);
+    for (bottom = NTT_LANES; bottom < n; bottom <<= k) {
+        for (k = 1; k < NTT_MERGE_MAX && (bottom << k) < n; k++) {
+        }
+        // the scaling is folded into the last pass
+        const int32_t lastScale = ((bottom << k) == n) ? scale : 0;
+        if (k == 3) {
+            NttInvMerged(a, zetas, n, bottom, 3, lastScale);
+        } else if (k == 2) {
+            NttInvMerged(a, zetas, n, bottom, 2, lastScale);
+        } else {
+            NttInvMerged(a, zetas, n, bottom, 1, lastScale);
+        }
+    }
+}
+#endif // POLAR_LAC_NTT_SIMD
+#endif // PQCP_POLARLAC
@@ -139,6 +139,8 @@ int32_t PQCP_POLAR_LAC_PkeKeyGen(CRYPT_POLAR_LAC_Ctx *ctx, uint8_t *seed)
     uint8_t e[dimN];
     uint8_t randBuf[seedLen * 3];
     int32_t ret = 0;
+    ctx->pkNttReady = false;
+    ctx->skNttReady = false;
     RETURN_RET_IF(PQCP_POLAR_LAC_PseudoRandomBytes(NULL, seed, seedLen, randBuf, seedLen * 3), ret);
     RETURN_RET_IF(PQCP_POLAR_LAC_SamplePolyA(NULL, Q, randBuf, seedLen, a, dimN), ret);
     // Copy the seed to the first part of pk: pk = seed | as+e;
@@ -147,30 +149,73 @@ int32_t PQCP_POLAR_LAC_PkeKeyGen(CRYPT_POLAR_LAC_Ctx *ctx, uint8_t *seed)
     RETURN_RET_IF(PQCP_POLAR_LAC_SampleSparseTernaryVector(NULL, Q, randBuf + seedLen, seedLen, sk, dimN, algId), ret);
     RETURN_RET_IF(PQCP_POLAR_LAC_SampleSparseTernaryVector(NULL, Q, randBuf + seedLen * 2, seedLen, e, dimN, algId),
                   ret);
-    PQCP_POLAR_LAC_PolyAff(a, sk, e, pk + seedLen, dimN, algId);
+    PQCP_POLAR_LAC_PolyNtt(a, ctx->nttA, algId);
+    PQCP_POLAR_LAC_PolyNtt(sk, ctx->nttS, algId);
+    ctx->skNttReady = true;
+    PQCP_POLAR_LAC_PolyAffNtt(ctx->nttA, ctx->nttS, e, pk + seedLen, dimN, algId);
+    // keep b in NTT form for later encryptions
+    PQCP_POLAR_LAC_PolyNtt(pk + seedLen, ctx->nttB, algId);
+    ctx->pkNttReady = true;
     // copy pk=as+e to the second part of sk, now sk=s|pk
     memcpy(sk + skLen - pkLen, pk, pkLen);
     return PQCP_SUCCESS;
 }
 
+int32_t PQCP_POLAR_LAC_PkePreparePk(CRYPT_POLAR_LAC_Ctx *ctx)
+{
+    uint32_t dimN = ctx->info->dimN;
+    uint32_t seedLen = ctx->info->seedLen;
+    uint8_t a[dimN];
+    int32_t ret = 0;
+    ctx->pkNttReady = false;
+    // gen_a(a,pk);
+    RETURN_RET_IF(PQCP_POLAR_LAC_SamplePolyA(NULL, Q, ctx->pk, seedLen, a, dimN), ret);
+    PQCP_POLAR_LAC_PolyNtt(a, ctx->nttA, ctx->algId);
+    PQCP_POLAR_LAC_PolyNtt(ctx->pk + seedLen, ctx->nttB, ctx->algId);
+    ctx->pkNttReady = true;
+    return PQCP_SUCCESS;
+}
+
+// c1=a*r+e1 and c2=b*r+e2 share the single forward NTT of r
+static int32_t PolarLacPkeAffR(const CRYPT_POLAR_LAC_Ctx *ctx, const uint8_t *r, const uint8_t *e1, const uint8_t *e2,
+                               uint8_t *c1, uint8_t *c2, uint32_t c2Len)
+{
+    uint32_t dimN = ctx->info->dimN;
+    int32_t ret = 0;
+    if (ctx->pkNttReady) {
+        // a and b are cached in NTT form, only r needs a forward NTT
+        int16_t rHat[dimN];
+        PQCP_POLAR_LAC_PolyNtt(r, rHat, ctx->algId);
+        PQCP_POLAR_LAC_PolyAffNtt(ctx->nttA, rHat, e1, c1, dimN, ctx->algId);
+        PQCP_POLAR_LAC_PolyAffNtt(ctx->nttB, rHat, e2, c2, c2Len, ctx->algId);
+        return PQCP_SUCCESS;
+    }
+    uint8_t a[dimN];
+    // gen_a(a,pk);
+    RETURN_RET_IF(PQCP_POLAR_LAC_SamplePolyA(NULL, Q, ctx->pk, ctx->info->seedLen, a, dimN), ret);
+    const uint8_t *partner[] = {a, ctx->pk + ctx->info->seedLen};
+    const uint8_t *e[] = {e1, e2};
+    uint8_t *out[] = {c1, c2};
+    const uint32_t vecNum[] = {dimN, c2Len};
+    PQCP_POLAR_LAC_PolyAffMulti(r, partner, e, out, vecNum, 2, ctx->algId);
+    return PQCP_SUCCESS;
+}
+
 // encryption with seed
 int32_t PQCP_POLAR_LAC_PkeEncrypt(const CRYPT_POLAR_LAC_Ctx *ctx, const uint8_t *m, uint8_t *c,
                                   uint32_t *clen, uint8_t *seed)
 {
-    const uint8_t *pk = ctx->pk;
     uint32_t dimN = ctx->info->dimN;
     uint32_t c2VecNum = ctx->info->c2VecNum;
     uint32_t seedLen = ctx->info->seedLen;
 
     uint8_t r[dimN];
     uint8_t e1[dimN], e2[dimN];
+    uint8_t c1[dimN];
     uint8_t c2[c2VecNum];
-    uint8_t a[dimN];
     uint8_t randBuf[seedLen * 3];
     int32_t c2Len;
     int32_t ret = 0;
-    // gen_a(a,pk);
-    RETURN_RET_IF(PQCP_POLAR_LAC_SamplePolyA(NULL, Q, pk, seedLen, a, dimN), ret);
     RETURN_RET_IF(PQCP_POLAR_LAC_PseudoRandomBytes(NULL, seed, seedLen, randBuf, seedLen * 3), ret);
     RETURN_RET_IF(PQCP_POLAR_LAC_SampleSparseTernaryVector(NULL, Q, randBuf, seedLen, r, dimN, ctx->algId), ret);
     RETURN_RET_IF(PQCP_POLAR_LAC_SampleSparseTernaryVector(NULL, Q, randBuf + seedLen, seedLen, e1, dimN, ctx->algId),
@@ -178,33 +223,22 @@ int32_t PQCP_POLAR_LAC_PkeEncrypt(const CRYPT_POLAR_LAC_Ctx *ctx, const uint8_t
     RETURN_RET_IF(
         PQCP_POLAR_LAC_SampleSparseTernaryVector(NULL, Q, randBuf + 2 * seedLen, seedLen, e2, dimN, ctx->algId), ret);
     EncodeToE2(e2, m, &c2Len, ctx->algId);
+    // generate c1: c1=a*r+e1, c2: c2=b*r+e2+m*[q/2]; c1 of LAC256 is not compressed
+    RETURN_RET_IF(PolarLacPkeAffR(ctx, r, e1, e2, ctx->algId == PQCP_POLAR_LAC_256 ? c : c1, c2, (uint32_t)c2Len),
+                  ret);
     if (ctx->algId == PQCP_POLAR_LAC_LIGHT) {
-        uint8_t c1[dimN];
-        // generate c1: c1=a*r+e1
-        PQCP_POLAR_LAC_PolyAff(a, r, e1, c1, dimN, ctx->algId);
         // compress c1
         PQCP_POLAR_LAC_PolyCompress(c1, c, dimN, 7);
-        // generate c2: c2=b*r+e2+m*[q/2]
-        PQCP_POLAR_LAC_PolyAff(pk + seedLen, r, e2, c2, c2Len, ctx->algId);
         // compress c2
         PQCP_POLAR_LAC_PolyCompress(c2, c + dimN * 7 / 8, c2Len, 4);
         *clen = dimN * 7 / 8 + c2Len / 2;
     } else if (ctx->algId == PQCP_POLAR_LAC_128) {
-        uint8_t c1[dimN];
-        // generate c1: c1=a*r+e1
-        PQCP_POLAR_LAC_PolyAff(a, r, e1, c1, dimN, ctx->algId);
         // compress c1
         PQCP_POLAR_LAC_PolyCompress(c1, c, dimN, 7);
-        // generate c2: c2=b*r+e2+m*[q/2]
-        PQCP_POLAR_LAC_PolyAff(pk + seedLen, r, e2, c2, c2Len, ctx->algId);
         // compress c2
         PQCP_POLAR_LAC_PolyCompress(c2, c + dimN * 7 / 8, c2Len, 3);
         *clen = dimN * 7 / 8 + c2Len * 3 / 8;
     } else if (ctx->algId == PQCP_POLAR_LAC_256) {
-        // generate c1: c1=a*r+e1
-        PQCP_POLAR_LAC_PolyAff(a, r, e1, c, dimN, ctx->algId);
-        // generate c2: c2=b*r+e2+m*[q/2]
-        PQCP_POLAR_LAC_PolyAff(pk + seedLen, r, e2, c2, c2Len, ctx->algId);
         // compress c2
         PQCP_POLAR_LAC_PolyCompress(c2, c + dimN, c2Len, 4);
         *clen = dimN + c2Len / 2;
@@ -212,10 +246,21 @@ int32_t PQCP_POLAR_LAC_PkeEncrypt(const CRYPT_POLAR_LAC_Ctx *ctx, const uint8_t
     return PQCP_SUCCESS;
 }
 
+// out=c1*s, using the cached NTT form of s when available
+static void PolarLacPkeMulS(const CRYPT_POLAR_LAC_Ctx *ctx, const uint8_t *c1, uint8_t *out, uint32_t vecNum)
+{
+    if (ctx->skNttReady) {
+        int16_t c1Hat[ctx->info->dimN];
+        PQCP_POLAR_LAC_PolyNtt(c1, c1Hat, ctx->algId);
+        PQCP_POLAR_LAC_PolyMulNtt(c1Hat, ctx->nttS, out, vecNum, ctx->algId);
+        return;
+    }
+    PQCP_POLAR_LAC_PolyMul(c1, ctx->sk, out, vecNum, ctx->algId);
+}
+
 int32_t PQCP_POLAR_LAC_PkeDecrypt(const CRYPT_POLAR_LAC_Ctx *ctx, const uint8_t *c, uint32_t clen, uint8_t *m,
                                   uint32_t *mlen)
 {
-    uint8_t *sk = ctx->sk;
     uint32_t dimN = ctx->info->dimN;
     uint32_t msgLen = ctx->info->msgLen;
     uint32_t c2VecNum = ctx->info->c2VecNum;
@@ -224,7 +269,7 @@ int32_t PQCP_POLAR_LAC_PkeDecrypt(const CRYPT_POLAR_LAC_Ctx *ctx, const uint8_t
     uint8_t out[dimN];
     uint8_t c2[c2VecNum];
     uint8_t mBuf[msgLen];
-    float llr[codeLen * 8]; // log-likelihood ratio of the received signal
+    int16_t llr[codeLen * 8]; // log-likelihood ratio of the received signal, in units of 1/halfTwo
 
     int32_t temp;
     int32_t half = 126; // Q/2
@@ -239,7 +284,7 @@ int32_t PQCP_POLAR_LAC_PkeDecrypt(const CRYPT_POLAR_LAC_Ctx *ctx, const uint8_t
         // c2 decompress
         PQCP_POLAR_LAC_PolyDecompress(c + dimN * 7 / 8, c2, c2Len, 4);
         // c1*sk
-        PQCP_POLAR_LAC_PolyMul(c1, sk, out, c2Len, ctx->algId);
+        PolarLacPkeMulS(ctx, c1, out, c2Len);
     } else if (ctx->algId == PQCP_POLAR_LAC_128) {
         uint8_t c1[dimN];
         c2Len = (clen - dimN * 7 / 8) / 3 * 8;
@@ -248,13 +293,13 @@ int32_t PQCP_POLAR_LAC_PkeDecrypt(const CRYPT_POLAR_LAC_Ctx *ctx, const uint8_t
         // c2 decompress
         PQCP_POLAR_LAC_PolyDecompress(c + dimN * 7 / 8, c2, c2Len, 3);
         // c1*sk
-        PQCP_POLAR_LAC_PolyMul(c1, sk, out, c2Len, ctx->algId);
+        PolarLacPkeMulS(ctx, c1, out, c2Len);
     } else {
         c2Len = (clen - dimN) * 2;
         // c2 decompress
         PQCP_POLAR_LAC_PolyDecompress(c + dimN, c2, c2Len, 4);
         // c1*sk
-        PQCP_POLAR_LAC_PolyMul(c, sk, out, c2Len, ctx->algId);
+        PolarLacPkeMulS(ctx, c, out, c2Len);
     }
 
     uint32_t dataLen = ctx->algId == PQCP_POLAR_LAC_256 ? 32 : 16;
@@ -269,7 +314,9 @@ int32_t PQCP_POLAR_LAC_PkeDecrypt(const CRYPT_POLAR_LAC_Ctx *ctx, const uint8_t
         if (temp >= half) {
             temp = temp - Q; // [126,187]——>[-125,-64]
         }
-        llr[i] = -(float)temp / halfTwo; // 0 is modulated to -q/4, and 1 is modulated to q/4
+        llr[i] = (int16_t)-temp; // 0 is modulated to -q/4, and 1 is modulated to q/4
+        // the llr are kept unscaled, the decoder is exact on them and decides a bit 1 only for a negative llr,
+        // so ties (llr 0) resolve to 0, see SDV_CRYPTO_PQCP_POLARLAC_DECODE_TC001
     }
 
     // polar decode to recover m
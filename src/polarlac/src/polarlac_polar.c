@@ -22,6 +22,11 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 #define sign_macro(x)      ((x > 0) - (x < 0))
 #define absl_macro(x)      (((x > 0) - (x < 0)) * x)
@@ -37,6 +42,21 @@ struct polarControl {
     uint32_t eccBytes; // N/8
 };
 
+// node types of the pruned decoding tree
+enum {
+    POLAR_RATE0 = 0, // all bits frozen, the codeword is 0
+    POLAR_RATE1 = 1, // all bits are message bits
+    POLAR_REP = 2, // only the last bit is a message bit, the codeword repeats it
+    POLAR_SPC = 3, // only the first bit is frozen, the codeword has even parity
+};
+
+// a subtree of 2^layer leaves starting at u_start, decoded in one step
+typedef struct {
+    uint16_t start;
+    uint8_t layer;
+    uint8_t type;
+} PolarNode;
+
 // message bit is 1, frozen bit is 0
 static uint8_t infoNodes112[] = {
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0,
@@ -51,27 +71,14 @@ static uint8_t infoNodes112[] = {
 // the values in lambdaOffset divide the intermediate result storage arrays P and C into segments
 static int32_t lambdaOffset112[9] = {1, 2, 4, 8, 16, 32, 64, 128, 256};
 
-// store the number of least significant zero bits in the binary representation of integers from 0 to N-1
-// llrLayerVec indicates the actual number of layers executed during LLR computation
-static int32_t llr_layer_vec_112[256] = {
-    0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 5, 0, 1, 0, 2,
-    0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 6, 0, 1, 0, 2, 0, 1, 0, 3, 0,
-    1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1,
-    0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 7, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0,
-    2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3,
-    0, 1, 0, 2, 0, 1, 0, 6, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0,
-    1, 0, 5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0};
-
-// store the number of least significant one bits minus 1 in the binary representation of integers from 0 to N-1
-// bitLayerVec indicates the actual number of layers executed when returning the bit values
-static int32_t bit_layer_vec_112[256] = {
-    0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 0, 1, 0,
-    0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 5, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0,
-    0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0,
-    3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 6, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1,
-    0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0,
-    0, 0, 1, 0, 0, 0, 5, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0,
-    0, 4, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 7};
+// pruned decoding tree of infoNodes112, {start, layer, type} of its nodes in decoding order
+static const PolarNode g_polarNodes112[] = {
+    {0, 5, POLAR_REP}, {32, 4, POLAR_REP}, {48, 3, POLAR_REP}, {56, 2, POLAR_REP}, {60, 2, POLAR_SPC},
+    {64, 4, POLAR_REP}, {80, 3, POLAR_REP}, {88, 2, POLAR_REP}, {92, 2, POLAR_RATE1}, {96, 2, POLAR_RATE0},
+    {100, 1, POLAR_RATE0}, {102, 1, POLAR_RATE1}, {104, 3, POLAR_SPC}, {112, 4, POLAR_SPC}, {128, 4, POLAR_REP},
+    {144, 3, POLAR_REP}, {152, 1, POLAR_RATE0}, {154, 1, POLAR_RATE1}, {156, 2, POLAR_RATE1}, {160, 2, POLAR_RATE0},
+    {164, 2, POLAR_SPC}, {168, 3, POLAR_SPC}, {176, 4, POLAR_SPC}, {192, 2, POLAR_REP}, {196, 2, POLAR_SPC},
+    {200, 3, POLAR_SPC}, {208, 4, POLAR_SPC}, {224, 5, POLAR_SPC}};
 
 static struct polarControl g_polar_112 = {.N = 256, .n = 8, .K = 128, .eccBytes = 32};
 
@@ -95,41 +102,18 @@ static uint8_t infoNodes128[] = {
 // the values in lambdaOffset divide the intermediate result storage arrays P and C into segments
 static int32_t lambdaOffset128[10] = {1, 2, 4, 8, 16, 32, 64, 128, 256, 512};
 
-// store the number of least significant zero bits in the binary representation of integers from 0 to N-1
-// llrLayerVec indicates the actual number of layers executed during LLR computation
-static int32_t llr_layer_vec_128[512] = {
-    0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 5, 0, 1, 0, 2,
-    0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 6, 0, 1, 0, 2, 0, 1, 0, 3, 0,
-    1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1,
-    0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 7, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0,
-    2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3,
-    0, 1, 0, 2, 0, 1, 0, 6, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0,
-    1, 0, 5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 8, 0, 1,
-    0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 5, 0, 1, 0, 2, 0, 1, 0,
-    3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 6, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2,
-    0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0,
-    1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 7, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1,
-    0, 3, 0, 1, 0, 2, 0, 1, 0, 5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0,
-    2, 0, 1, 0, 6, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 5,
-    0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0};
-
-// store the number of least significant one bits minus 1 in the binary representation of integers from 0 to N-1
-// bitLayerVec indicates the actual number of layers executed when returning the bit values
-static int32_t bit_layer_vec_128[512] = {
-    0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 0, 1, 0,
-    0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 5, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0,
-    0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0,
-    3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 6, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1,
-    0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0,
-    0, 0, 1, 0, 0, 0, 5, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0,
-    0, 4, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 7, 0, 0, 0,
-    1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 0, 1, 0, 0, 0, 2,
-    0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 5, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0,
-    0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0,
-    0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 6, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0,
-    2, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1,
-    0, 0, 0, 5, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 4, 0,
-    0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 8};
+// pruned decoding tree of infoNodes128, {start, layer, type} of its nodes in decoding order
+static const PolarNode g_polarNodes128[] = {
+    {0, 7, POLAR_REP}, {128, 5, POLAR_RATE0}, {160, 4, POLAR_RATE0}, {176, 3, POLAR_RATE0}, {184, 2, POLAR_REP},
+    {188, 2, POLAR_SPC}, {192, 4, POLAR_REP}, {208, 3, POLAR_REP}, {216, 2, POLAR_REP}, {220, 2, POLAR_SPC},
+    {224, 3, POLAR_REP}, {232, 2, POLAR_REP}, {236, 2, POLAR_SPC}, {240, 2, POLAR_REP}, {244, 2, POLAR_SPC},
+    {248, 3, POLAR_SPC}, {256, 5, POLAR_RATE0}, {288, 4, POLAR_REP}, {304, 3, POLAR_REP}, {312, 2, POLAR_REP},
+    {316, 2, POLAR_SPC}, {320, 4, POLAR_REP}, {336, 3, POLAR_REP}, {344, 2, POLAR_REP}, {348, 2, POLAR_SPC},
+    {352, 3, POLAR_REP}, {360, 2, POLAR_REP}, {364, 2, POLAR_SPC}, {368, 2, POLAR_REP}, {372, 2, POLAR_SPC},
+    {376, 3, POLAR_SPC}, {384, 4, POLAR_REP}, {400, 3, POLAR_REP}, {408, 2, POLAR_REP}, {412, 2, POLAR_SPC},
+    {416, 3, POLAR_REP}, {424, 2, POLAR_REP}, {428, 2, POLAR_SPC}, {432, 2, POLAR_REP}, {436, 2, POLAR_SPC},
+    {440, 3, POLAR_SPC}, {448, 3, POLAR_REP}, {456, 2, POLAR_REP}, {460, 2, POLAR_RATE1}, {464, 1, POLAR_RATE0},
+    {466, 1, POLAR_RATE1}, {468, 2, POLAR_RATE1}, {472, 3, POLAR_RATE1}, {480, 5, POLAR_SPC}};
 
 static struct polarControl g_polar_128 = {.N = 512, .n = 9, .K = 128, .eccBytes = 64};
 
@@ -154,41 +138,22 @@ static uint8_t infoNodes256[] = {
 // the values in lambdaOffset divide the intermediate result storage arrays P and C into segments
 static int32_t lambdaOffset256[10] = {1, 2, 4, 8, 16, 32, 64, 128, 256, 512};
 
-// store the number of least significant zero bits in the binary representation of integers from 0 to N-1
-// llrLayerVec indicates the actual number of layers executed during LLR computation
-static int32_t llr_layer_vec_256[512] = {
-    0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 5, 0, 1, 0, 2,
-    0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 6, 0, 1, 0, 2, 0, 1, 0, 3, 0,
-    1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1,
-    0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 7, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0,
-    2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3,
-    0, 1, 0, 2, 0, 1, 0, 6, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0,
-    1, 0, 5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 8, 0, 1,
-    0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 5, 0, 1, 0, 2, 0, 1, 0,
-    3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 6, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2,
-    0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0,
-    1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 7, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1,
-    0, 3, 0, 1, 0, 2, 0, 1, 0, 5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0,
-    2, 0, 1, 0, 6, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 5,
-    0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0};
-
-// store the number of least significant one bits minus 1 in the binary representation of integers from 0 to N-1
-// bitLayerVec indicates the actual number of layers executed when returning the bit values
-static int32_t bit_layer_vec_256[512] = {
-    0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 0, 1, 0,
-    0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 5, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0,
-    0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0,
-    3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 6, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1,
-    0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0,
-    0, 0, 1, 0, 0, 0, 5, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0,
-    0, 4, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 7, 0, 0, 0,
-    1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 0, 1, 0, 0, 0, 2,
-    0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 5, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0,
-    0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0,
-    0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 6, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0,
-    2, 0, 0, 0, 1, 0, 0, 0, 4, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1,
-    0, 0, 0, 5, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 4, 0,
-    0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 8};
+// pruned decoding tree of infoNodes256, {start, layer, type} of its nodes in decoding order
+static const PolarNode g_polarNodes256[] = {
+    {0, 5, POLAR_REP}, {32, 4, POLAR_REP}, {48, 3, POLAR_REP}, {56, 2, POLAR_REP}, {60, 2, POLAR_SPC},
+    {64, 4, POLAR_REP}, {80, 3, POLAR_REP}, {88, 2, POLAR_REP}, {92, 2, POLAR_SPC}, {96, 3, POLAR_REP},
+    {104, 2, POLAR_REP}, {108, 2, POLAR_SPC}, {112, 2, POLAR_REP}, {116, 2, POLAR_SPC}, {120, 3, POLAR_SPC},
+    {128, 4, POLAR_REP}, {144, 3, POLAR_REP}, {152, 2, POLAR_REP}, {156, 2, POLAR_SPC}, {160, 3, POLAR_REP},
+    {168, 2, POLAR_REP}, {172, 2, POLAR_SPC}, {176, 2, POLAR_REP}, {180, 2, POLAR_SPC}, {184, 3, POLAR_SPC},
+    {192, 3, POLAR_REP}, {200, 2, POLAR_REP}, {204, 2, POLAR_SPC}, {208, 2, POLAR_REP}, {212, 2, POLAR_SPC},
+    {216, 3, POLAR_SPC}, {224, 2, POLAR_REP}, {228, 2, POLAR_SPC}, {232, 3, POLAR_SPC}, {240, 4, POLAR_SPC},
+    {256, 4, POLAR_REP}, {272, 3, POLAR_REP}, {280, 2, POLAR_REP}, {284, 2, POLAR_SPC}, {288, 3, POLAR_REP},
+    {296, 2, POLAR_REP}, {300, 2, POLAR_SPC}, {304, 2, POLAR_REP}, {308, 2, POLAR_SPC}, {312, 3, POLAR_SPC},
+    {320, 3, POLAR_REP}, {328, 2, POLAR_REP}, {332, 2, POLAR_SPC}, {336, 2, POLAR_REP}, {340, 2, POLAR_SPC},
+    {344, 3, POLAR_SPC}, {352, 2, POLAR_REP}, {356, 2, POLAR_SPC}, {360, 3, POLAR_SPC}, {368, 4, POLAR_SPC},
+    {384, 3, POLAR_REP}, {392, 2, POLAR_REP}, {396, 2, POLAR_SPC}, {400, 2, POLAR_REP}, {404, 2, POLAR_SPC},
+    {408, 3, POLAR_SPC}, {416, 2, POLAR_REP}, {420, 2, POLAR_SPC}, {424, 3, POLAR_SPC}, {432, 4, POLAR_SPC},
+    {448, 2, POLAR_REP}, {452, 2, POLAR_SPC}, {456, 3, POLAR_SPC}, {464, 4, POLAR_SPC}, {480, 5, POLAR_SPC}};
 
 static struct polarControl g_polar_256 = {.N = 512, .n = 9, .K = 256, .eccBytes = 64};
 
@@ -233,135 +198,309 @@ void PQCP_POLAR_LAC_EncodePolar(uint8_t *u, int32_t algId)
     }
 }
 
-/**
- * polar decode
- * Algorithm idea inspired by:
- * https://github.com/YuYongRun/PolarCodeDecodersInMatlab (Repository does not specify a license)
- */
-void PQCP_POLAR_LAC_DecodePolar(uint8_t *m_cap, const float *llr, int32_t algId)
+// f on a whole layer: out[k] = sign(a[k]) * sign(b[k]) * min(|a[k]|, |b[k]|).
+// The min is 0 whenever a[k] or b[k] is 0, so the sign of the product is the sign bit of a[k] ^ b[k].
+static void PolarLayerF(int16_t *out, const int16_t *a, const int16_t *b, int32_t len)
+{
+    int32_t k = 0;
+#if defined(__AVX2__)
+    for (; k + 16 <= len; k += 16) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + k));
+        __m256i y = _mm256_loadu_si256((const __m256i *)(b + k));
+        __m256i m = _mm256_min_epi16(_mm256_abs_epi16(x), _mm256_abs_epi16(y));
+        __m256i s = _mm256_srai_epi16(_mm256_xor_si256(x, y), 15);
+        _mm256_storeu_si256((__m256i *)(out + k), _mm256_sub_epi16(_mm256_xor_si256(m, s), s));
+    }
+#elif defined(__ARM_NEON)
+    for (; k + 8 <= len; k += 8) {
+        int16x8_t x = vld1q_s16(a + k);
+        int16x8_t y = vld1q_s16(b + k);
+        int16x8_t m = vminq_s16(vabsq_s16(x), vabsq_s16(y));
+        int16x8_t s = vshrq_n_s16(veorq_s16(x, y), 15);
+        vst1q_s16(out + k, vsubq_s16(veorq_s16(m, s), s));
+    }
+#endif
+    for (; k < len; k++) {
+        int32_t m = mini_macro(abs(a[k]), abs(b[k]));
+        int32_t sign = (a[k] ^ b[k]) >> 15;
+        out[k] = (int16_t)((m ^ sign) - sign);
+    }
+}
+
+// g on a whole layer: out[k] = (1 - 2 * u[k]) * a[k] + b[k], the negation is done with the mask -u[k]
+static void PolarLayerG(int16_t *out, const uint8_t *u, const int16_t *a, const int16_t *b, int32_t len)
+{
+    int32_t k = 0;
+#if defined(__AVX2__)
+    for (; k + 16 <= len; k += 16) {
+        __m256i m = _mm256_sub_epi16(_mm256_setzero_si256(),
+                                     _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(u + k))));
+        __m256i x = _mm256_loadu_si256((const __m256i *)(a + k));
+        __m256i y = _mm256_loadu_si256((const __m256i *)(b + k));
+        x = _mm256_sub_epi16(_mm256_xor_si256(x, m), m);
+        _mm256_storeu_si256((__m256i *)(out + k), _mm256_add_epi16(x, y));
+    }
+#elif defined(__ARM_NEON)
+    for (; k + 8 <= len; k += 8) {
+        int16x8_t m = vnegq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(u + k))));
+        int16x8_t x = vld1q_s16(a + k);
+        int16x8_t y = vld1q_s16(b + k);
+        x = vsubq_s16(veorq_s16(x, m), m);
+        vst1q_s16(out + k, vaddq_s16(x, y));
+    }
+#endif
+    for (; k < len; k++) {
+        out[k] = (int16_t)g_macro(u[k], a[k], b[k]);
+    }
+}
+
+// Masks of the negative and of the zero entries of a[0 .. size - 1], size <= 32
+static void PolarSignMasks(uint32_t *neg, uint32_t *zero, const int16_t *a, int32_t size)
+{
+    uint32_t negMask = 0;
+    uint32_t zeroMask = 0;
+    for (int32_t k = 0; k < size; k++) {
+        negMask |= (uint32_t)(a[k] < 0) << k;
+        zeroMask |= (uint32_t)(a[k] == 0) << k;
+    }
+    *neg = negMask;
+    *zero = zeroMask;
+}
+
+// SC decoding of a rate-1 node of size <= 32 from the masks of its negative and zero llr, returns the codeword as a mask.
+// Without frozen bits f and g only depend on the signs, so SC is followed exactly, including the ties at llr 0 where a
+// plain hard decision on each llr would differ.
+static uint32_t PolarRate1(uint32_t neg, uint32_t zero, int32_t size)
+{
+    if (size == 1) {
+        return neg;
+    }
+    const int32_t h = size / 2;
+    const uint32_t low = (1u << h) - 1;
+    const uint32_t negA = neg & low;
+    const uint32_t negB = neg >> h;
+    const uint32_t zeroA = zero & low;
+    const uint32_t zeroB = zero >> h;
+    // f(a, b) is 0 if a or b is 0, otherwise negative if exactly one of them is
+    const uint32_t zeroL = zeroA | zeroB;
+    const uint32_t betaL = PolarRate1((negA ^ negB) & ~zeroL, zeroL, h);
+    // the decision on f(a, b) gives (1 - 2 * betaL) * a the sign of b, so g(betaL, a, b) has the sign of b,
+    // or the sign of (1 - 2 * betaL) * a when b is 0
+    const uint32_t negR = negB | (zeroB & ~zeroA & (negA ^ betaL));
+    const uint32_t betaR = PolarRate1(negR, zeroA & zeroB, h);
+    return (betaL ^ betaR) | (betaR << h);
+}
+
+// SC decoding of an SPC node of 2^layer <= 32 bits whose llr are at layer `layer` of interLlr, returns the codeword as
+// a mask. The left child is again an SPC node, or a REP node of 2 bits at layer 1, and the right child a rate-1 node.
+static uint32_t PolarSpc(int16_t *interLlr, int32_t layer)
+{
+    const int32_t h = 1 << (layer - 1);
+    const int16_t *a = interLlr + 2 * h - 1;
+    const int16_t *b = a + h;
+    int16_t *left = interLlr + h - 1;
+    uint32_t betaL;
+    uint32_t negR = 0;
+    uint32_t zeroR = 0;
+
+    PolarLayerF(left, a, b, h);
+    if (layer == 2) {
+        betaL = 3 * (uint32_t)(left[0] + left[1] < 0);
+    } else {
+        betaL = PolarSpc(interLlr, layer - 1);
+    }
+    for (int32_t k = 0; k < h; k++) {
+        int32_t m = -(int32_t)((betaL >> k) & 1);
+        int32_t r = ((a[k] ^ m) - m) + b[k];
+        negR |= (uint32_t)(r < 0) << k;
+        zeroR |= (uint32_t)(r == 0) << k;
+    }
+    const uint32_t betaR = PolarRate1(negR, zeroR, h);
+    return (betaL ^ betaR) | (betaR << h);
+}
+
+// The butterflies of PQCP_POLAR_LAC_EncodePolar on a mask of size <= 32 bits, the transform is its own inverse
+static uint32_t PolarTransformMask(uint32_t x, int32_t size)
+{
+    static const uint32_t keep[5] = {0x55555555, 0x33333333, 0x0F0F0F0F, 0x00FF00FF, 0x0000FFFF};
+    for (int32_t s = 0; (1 << s) < size; s++) {
+        x ^= (x >> (1 << s)) & keep[s];
+    }
+    return x;
+}
+
+// parameters, llr segment sizes, pruned decoding tree and frozen bit pattern of the code of algId, NULL if unknown
+static const struct polarControl *PolarSelectCode(int32_t algId, int32_t **lambdaOffset, const PolarNode **nodes,
+                                                  int32_t *nodeNum, const uint8_t **infoNodes)
 {
-    struct polarControl *polar = NULL;
-    int32_t *lambdaOffset = NULL;
-    int32_t *llrLayerVec = NULL;
-    int32_t *bitLayerVec = NULL;
-    uint8_t *infoNodes = NULL;
     switch (algId) {
         case PQCP_POLAR_LAC_LIGHT:
-            polar = &g_polar_112;
-            lambdaOffset = lambdaOffset112;
-            llrLayerVec = llr_layer_vec_112;
-            bitLayerVec = bit_layer_vec_112;
-            infoNodes = infoNodes112;
-            break;
+            *lambdaOffset = lambdaOffset112;
+            *nodes = g_polarNodes112;
+            *nodeNum = (int32_t)(sizeof(g_polarNodes112) / sizeof(g_polarNodes112[0]));
+            *infoNodes = infoNodes112;
+            return &g_polar_112;
         case PQCP_POLAR_LAC_128:
-            polar = &g_polar_128;
-            lambdaOffset = lambdaOffset128;
-            llrLayerVec = llr_layer_vec_128;
-            bitLayerVec = bit_layer_vec_128;
-            infoNodes = infoNodes128;
-            break;
+            *lambdaOffset = lambdaOffset128;
+            *nodes = g_polarNodes128;
+            *nodeNum = (int32_t)(sizeof(g_polarNodes128) / sizeof(g_polarNodes128[0]));
+            *infoNodes = infoNodes128;
+            return &g_polar_128;
         case PQCP_POLAR_LAC_256:
-            polar = &g_polar_256;
-            lambdaOffset = lambdaOffset256;
-            llrLayerVec = llr_layer_vec_256;
-            bitLayerVec = bit_layer_vec_256;
-            infoNodes = infoNodes256;
-            break;
+            *lambdaOffset = lambdaOffset256;
+            *nodes = g_polarNodes256;
+            *nodeNum = (int32_t)(sizeof(g_polarNodes256) / sizeof(g_polarNodes256[0]));
+            *infoNodes = infoNodes256;
+            return &g_polar_256;
+        default:
+            return NULL;
     }
-    uint8_t interBit[2 * polar->N - 1][2]; // internal bit vector
-    float interLlr[polar->N - 1]; // internal llr vector, interLlr[0] used for decision
-    int32_t msgIndex = 0;
-    // decode each u_i
-    for (uint32_t i = 0; i < polar->N; i++) {
-        if (i == 0) {
-            int32_t index1 = lambdaOffset[polar->n - 1];
-            int32_t beta = 0;
-            int32_t end_beta = index1 - 1;
-
-            for (; beta <= end_beta; beta++) {
-                interLlr[beta + index1 - 1] = f_macro(llr[beta], llr[beta + index1]);
-            }
-
-            for (int32_t layer = polar->n - 2; layer >= 0; layer--) {
-                int32_t index1 = lambdaOffset[layer];
-                int32_t index2 = lambdaOffset[layer + 1];
-                int32_t beta = index1 - 1;
-                int32_t end_beta = index2 - 2;
-
-                for (; beta <= end_beta; beta++) {
-                    interLlr[beta] = f_macro(interLlr[beta + index1], interLlr[beta + index2]);
-                }
-            }
-        } else if (i == polar->N / 2) {
-            int32_t index1 = lambdaOffset[polar->n - 1];
-            int32_t beta = 0;
-            int32_t end_beta = index1 - 1;
+}
 
-            for (; beta <= end_beta; beta++) {
-                interLlr[beta + index1 - 1] = g_macro(interBit[beta + index1 - 1][0], llr[beta], llr[beta + index1]);
-            }
+// whether the 2^layer bits from start, ones of them message bits, fit the node type within the sizes the decoder
+// supports for it
+static bool PolarNodeMatches(const uint8_t *infoNodes, uint32_t start, uint32_t layer, uint32_t ones, uint8_t type)
+{
+    const uint32_t size = 1u << layer;
+    switch (type) {
+        case POLAR_RATE0:
+            return ones == 0;
+        case POLAR_RATE1:
+            return ones == size && size <= 32;
+        case POLAR_REP:
+            return ones == 1 && infoNodes[start + size - 1] != 0;
+        case POLAR_SPC:
+            return ones == size - 1 && infoNodes[start] == 0 && layer >= 2 && size <= 32;
+        default:
+            return false;
+    }
+}
 
-            for (int32_t layer = polar->n - 2; layer >= 0; layer--) {
-                int32_t index1 = lambdaOffset[layer];
-                int32_t index2 = lambdaOffset[layer + 1];
-                int32_t beta = index1 - 1;
-                int32_t end_beta = index2 - 2;
+int32_t PQCP_POLAR_LAC_CheckPolarNodes(int32_t algId)
+{
+    int32_t *lambdaOffset = NULL;
+    const PolarNode *nodes = NULL;
+    int32_t nodeNum = 0;
+    const uint8_t *infoNodes = NULL;
+    const struct polarControl *polar = PolarSelectCode(algId, &lambdaOffset, &nodes, &nodeNum, &infoNodes);
+    if (polar == NULL) {
+        return PQCP_INVALID_ARG;
+    }
+    // the nodes must cover u_0 .. u_(N-1) in order, each aligned to its size, with 1 <= layer < n
+    uint32_t next = 0;
+    uint32_t msgNum = 0;
+    for (int32_t j = 0; j < nodeNum; j++) {
+        const uint32_t start = nodes[j].start;
+        const uint32_t layer = nodes[j].layer;
+        if (start != next || layer < 1 || layer >= polar->n || (start & ((1u << layer) - 1)) != 0) {
+            return PQCP_INVALID_ARG;
+        }
+        uint32_t ones = 0;
+        for (uint32_t k = 0; k < (1u << layer); k++) {
+            ones += (infoNodes[start + k] != 0);
+        }
+        if (!PolarNodeMatches(infoNodes, start, layer, ones, nodes[j].type)) {
+            return PQCP_INVALID_ARG;
+        }
+        msgNum += ones;
+        next = start + (1u << layer);
+    }
+    return (next == polar->N && msgNum == polar->K) ? PQCP_SUCCESS : PQCP_INVALID_ARG;
+}
 
-                for (; beta <= end_beta; beta++) {
-                    interLlr[beta] = f_macro(interLlr[beta + index1], interLlr[beta + index2]);
-                }
+/**
+ * polar decode
+ * Algorithm idea inspired by:
+ * https://github.com/YuYongRun/PolarCodeDecodersInMatlab (Repository does not specify a license)
+ * The SC decoder walks the pruned tree of g_polarNodes instead of every u_i: rate-0 nodes are skipped, and the
+ * other nodes are decided at once with the same result as SC on their leaves.
+ * All arithmetic is exact on int16 llr, and SC decides u_i = 1 only if its llr is negative, so an llr of 0 gives 0.
+ */
+void PQCP_POLAR_LAC_DecodePolar(uint8_t *m_cap, const int16_t *llr, int32_t algId)
+{
+    int32_t *lambdaOffset = NULL;
+    const PolarNode *nodes = NULL;
+    int32_t nodeNum = 0;
+    const uint8_t *infoNodes = NULL;
+    const struct polarControl *polar = PolarSelectCode(algId, &lambdaOffset, &nodes, &nodeNum, &infoNodes);
+    const int32_t n = (int32_t)polar->n;
+    // internal bit vectors, interBit[c] holds the codewords returned by the left (c = 0) or right (c = 1) children
+    uint8_t interBit[2][2 * polar->N - 1];
+    // internal llr vector, layer l occupies [2^l - 1, 2^(l+1) - 2]. |llr| <= 125 gives |interLlr| <= 125 * N / 2^l,
+    // which fits int16 for l >= 1; no node has layer 0.
+    int16_t interLlr[polar->N - 1];
+    int32_t msgIndex = 0;
+    // decode each node
+    for (int32_t j = 0; j < nodeNum; j++) {
+        const int32_t start = nodes[j].start;
+        const int32_t layer = nodes[j].layer;
+        const int32_t size = lambdaOffset[layer];
+        // g is applied at the layer where the node starts a right subtree, then f down to the node; the first node
+        // and the one at N/2 start from the channel llr. A rate-0 node only needs the llr of its left ancestors.
+        int32_t top = n - 1;
+        if (start != 0) {
+            for (top = 0; ((start >> top) & 1) == 0; top++) {
             }
-        } else {
-            int32_t llrLayer = llrLayerVec[i];
-            int32_t index1 = lambdaOffset[llrLayer];
-            int32_t index2 = lambdaOffset[llrLayer + 1];
-            int32_t beta = index1 - 1;
-            int32_t end_beta = index2 - 2;
-
-            for (; beta <= end_beta; beta++) {
-                interLlr[beta] = g_macro(interBit[beta][0], interLlr[beta + index1], interLlr[beta + index2]);
+        }
+        int32_t bottom = (nodes[j].type == POLAR_RATE0) ? layer + 1 : layer;
+        if (top >= bottom) {
+            int32_t index1 = lambdaOffset[top];
+            const int16_t *parent = (top == n - 1) ? llr : interLlr + 2 * index1 - 1;
+            if (start == 0) {
+                PolarLayerF(interLlr + index1 - 1, parent, parent + index1, index1);
+            } else {
+                PolarLayerG(interLlr + index1 - 1, interBit[0] + index1 - 1, parent, parent + index1, index1);
             }
-
-            for (int32_t layer = llrLayer - 1; layer >= 0; layer--) {
-                int32_t index1 = lambdaOffset[layer];
-                int32_t index2 = lambdaOffset[layer + 1];
-                int32_t beta = index1 - 1;
-                int32_t end_beta = index2 - 2;
-
-                for (; beta <= end_beta; beta++) {
-                    interLlr[beta] = f_macro(interLlr[beta + index1], interLlr[beta + index2]);
-                }
+            for (int32_t l = top - 1; l >= bottom; l--) {
+                index1 = lambdaOffset[l];
+                PolarLayerF(interLlr + index1 - 1, interLlr + 2 * index1 - 1, interLlr + 3 * index1 - 1, index1);
             }
         }
 
-        int32_t i_mod_2 = i & 1;
-        if (infoNodes[i] == 0) {
-            interBit[0][i_mod_2] = 0;
-        } else {
-            int32_t u_i = (interLlr[0] < 0); // decision
-            interBit[0][i_mod_2] = u_i;
+        const int16_t *alpha = interLlr + size - 1;
+        uint8_t *beta = interBit[(start >> layer) & 1] + size - 1;
+        if (nodes[j].type == POLAR_RATE0) {
+            memset(beta, 0, size);
+        } else if (nodes[j].type == POLAR_REP) {
+            int32_t sum = 0;
+            for (int32_t k = 0; k < size; k++) {
+                sum += alpha[k];
+            }
+            uint8_t u_i = (uint8_t)(sum < 0); // decision
+            memset(beta, u_i, size);
             m_cap[msgIndex] = u_i;
             msgIndex++;
-        }
-        // bit recursion
-        if (i_mod_2 == 1) {
-            int32_t bitLayer = bitLayerVec[i];
-            int32_t index1;
-            int32_t index2;
-            for (int32_t layer = 0; layer <= bitLayer - 1; layer++) {
-                index1 = lambdaOffset[layer];
-                index2 = lambdaOffset[layer + 1];
-                for (int32_t beta = index1 - 1; beta <= index2 - 2; beta++) {
-                    interBit[beta + index1][1] = interBit[beta][0] ^ interBit[beta][1];
-                    interBit[beta + index2][1] = interBit[beta][1];
+        } else {
+            uint32_t x;
+            if (nodes[j].type == POLAR_RATE1) {
+                uint32_t neg;
+                uint32_t zero;
+                PolarSignMasks(&neg, &zero, alpha, size);
+                x = PolarRate1(neg, zero, size);
+            } else {
+                x = PolarSpc(interLlr, layer);
+            }
+            for (int32_t k = 0; k < size; k++) {
+                beta[k] = (uint8_t)((x >> k) & 1);
+            }
+            // the message bits are the information positions of u = x * F^(layer)
+            uint32_t u = PolarTransformMask(x, size);
+            for (int32_t k = 0; k < size; k++) {
+                if (infoNodes[start + k] != 0) {
+                    m_cap[msgIndex] = (uint8_t)((u >> k) & 1);
+                    msgIndex++;
                 }
             }
+        }
 
-            index1 = lambdaOffset[bitLayer];
-            index2 = lambdaOffset[bitLayer + 1];
-            for (int32_t beta = index1 - 1; beta <= index2 - 2; beta++) {
-                interBit[beta + index1][0] = interBit[beta][0] ^ interBit[beta][1];
-                interBit[beta + index2][0] = interBit[beta][1];
+        // bit recursion, combine the finished right subtrees up to the first left child
+        for (int32_t m = layer; m < n - 1 && ((start >> m) & 1) == 1; m++) {
+            int32_t index1 = lambdaOffset[m];
+            int32_t index2 = lambdaOffset[m + 1];
+            uint8_t *up = interBit[(start >> (m + 1)) & 1];
+            for (int32_t b = index1 - 1; b <= index2 - 2; b++) {
+                up[b + index1] = interBit[0][b] ^ interBit[1][b];
+                up[b + index2] = interBit[1][b];
             }
         }
     }
@@ -25,137 +25,122 @@
 #define POLAR_LAC_256_DIM 1024
 #define POLAR_LAC_LIGHT_128_DIM 512
 
-static void PQCP_POLAR_LAC_PolyMulNttLazy(const uint16_t *a, const uint16_t *s, uint16_t *b)
+// map a to the lifted ring with NTTQ as the modulus
+static void PolarLacPolyLift(const uint8_t *a, int16_t *out, uint32_t dimN)
 {
-    int32_t i;
-    int16_t aBuf[POLAR_LAC_LIGHT_128_DIM], sBuf[POLAR_LAC_LIGHT_128_DIM], bBuf[POLAR_LAC_LIGHT_128_DIM];
+    uint32_t i;
+    uint16_t mask;
+    uint16_t a1, a2Tmp;
+    for (i = 0; i < dimN; i++) {
+        mask = (a[i] >= q_half);
+        a1 = a[i] + Q_sub_q;
+        a2Tmp = a[i] + NTTQ;
+        out[i] = (int16_t)((a1 & (-mask)) | (a2Tmp & (~(-mask))));
+    }
+}
 
-    for (i = 0; i < POLAR_LAC_LIGHT_128_DIM; i++) {
-        aBuf[i] = a[i];
-        sBuf[i] = s[i];
+// aHat = NTT(lift(a)), the lazy NTT form consumed by PQCP_POLAR_LAC_PolyMulNtt/PolyAffNtt
+void PQCP_POLAR_LAC_PolyNtt(const uint8_t *a, int16_t *aHat, int32_t algId)
+{
+    if (algId == PQCP_POLAR_LAC_256) {
+        PolarLacPolyLift(a, aHat, POLAR_LAC_256_DIM);
+        PQCP_PQCP_POLAR_LAC_NttLazy1024(aHat);
+    } else {
+        PolarLacPolyLift(a, aHat, POLAR_LAC_LIGHT_128_DIM);
+        PQCP_POLAR_LAC_NttLazy(aHat);
     }
+}
 
-    // NTT form
-    PQCP_POLAR_LAC_NttLazy(aBuf);
-    PQCP_POLAR_LAC_NttLazy(sBuf);
+// b2 = INTT(aHat * sHat) in [0, NTTQ)
+static void PolarLacPolyPointMulIntt(const int16_t *aHat, const int16_t *sHat, uint16_t *b2, int32_t algId)
+{
+    uint32_t i;
+    uint32_t dimN = algId == PQCP_POLAR_LAC_256 ? POLAR_LAC_256_DIM : POLAR_LAC_LIGHT_128_DIM;
+    int16_t bBuf[dimN];
 
     // point mul
-    for (i = 0; i < POLAR_LAC_LIGHT_128_DIM; i++) {
-        bBuf[i] = MontgomeryMapFull((int32_t)aBuf[i] * (int32_t)sBuf[i]);
+    for (i = 0; i < dimN; i++) {
+        bBuf[i] = MontgomeryMapFull((int32_t)aHat[i] * (int32_t)sHat[i]);
         // There will introduced a Montgomery factor β^(-1) mod NTTQ
         // So we perform the multiplication with N^(-1)*β mod NTTQ in the final step of INTT
     }
 
     // INTT form
-    PQCP_POLAR_LAC_InttLazy(bBuf);
+    if (algId == PQCP_POLAR_LAC_256) {
+        PQCP_PQCP_POLAR_LAC_InttLazy1024(bBuf);
+    } else {
+        PQCP_POLAR_LAC_InttLazy(bBuf);
+    }
 
     // mod Q
-    for (i = 0; i < POLAR_LAC_LIGHT_128_DIM; i++) {
-        b[i] = (bBuf[i] + NTTQ) % NTTQ; // To ensure the results are all positive numbers.
+    for (i = 0; i < dimN; i++) {
+        b2[i] = (bBuf[i] + NTTQ) % NTTQ; // To ensure the results are all positive numbers.
     }
 }
 
-static void PQCP_POLAR_LAC_PolyMulNttLazy1024(const uint16_t *a, const uint16_t *s, uint16_t *b)
+// map back to the original ring with Q as the modulus
+static inline uint8_t PolarLacPolyUnlift(uint16_t b2)
 {
-    int32_t i;
-    int16_t aBuf[POLAR_LAC_256_DIM], sBuf[POLAR_LAC_256_DIM], bBuf[POLAR_LAC_256_DIM];
+    uint16_t mask = (b2 < Q_half);
+    uint16_t b1 = b2 + NTTQ;
+    b2 = (b1 & (-mask)) | (b2 & (~(-mask)));
+    return (uint8_t)((b2 + neg_Q_mod_q) % Q);
+}
 
-    for (i = 0; i < POLAR_LAC_256_DIM; i++) {
-        aBuf[i] = a[i];
-        sBuf[i] = s[i];
+// b=as with a and s given in NTT form, see PQCP_POLAR_LAC_PolyNtt
+void PQCP_POLAR_LAC_PolyMulNtt(const int16_t *aHat, const int16_t *sHat, uint8_t *b, uint32_t vecNum, int32_t algId)
+{
+    uint32_t dimN = algId == PQCP_POLAR_LAC_256 ? POLAR_LAC_256_DIM : POLAR_LAC_LIGHT_128_DIM;
+    uint16_t b2[dimN];
+    PolarLacPolyPointMulIntt(aHat, sHat, b2, algId);
+    for (uint32_t i = 0; i < vecNum; i++) {
+        b[i] = PolarLacPolyUnlift(b2[i]);
     }
+}
 
-    // NTT form
-    PQCP_PQCP_POLAR_LAC_NttLazy1024(aBuf);
-    PQCP_PQCP_POLAR_LAC_NttLazy1024(sBuf);
-
-    // point mul
-    for (i = 0; i < POLAR_LAC_256_DIM; i++) {
-        bBuf[i] = MontgomeryMapFull((int32_t)aBuf[i] * (int32_t)sBuf[i]);
+// b=as+e with a and s given in NTT form, see PQCP_POLAR_LAC_PolyNtt
+void PQCP_POLAR_LAC_PolyAffNtt(const int16_t *aHat, const int16_t *sHat, const uint8_t *e, uint8_t *b, uint32_t vecNum,
+                               int32_t algId)
+{
+    uint32_t dimN = algId == PQCP_POLAR_LAC_256 ? POLAR_LAC_256_DIM : POLAR_LAC_LIGHT_128_DIM;
+    uint16_t b2[dimN];
+    PolarLacPolyPointMulIntt(aHat, sHat, b2, algId);
+    for (uint32_t i = 0; i < vecNum; i++) {
+        b[i] = (PolarLacPolyUnlift(b2[i]) + e[i] + Q) % Q;
     }
+}
 
-    // INTT form
-    PQCP_PQCP_POLAR_LAC_InttLazy1024(bBuf);
-
-    // mod Q
-    for (i = 0; i < POLAR_LAC_256_DIM; i++) {
-        b[i] = (bBuf[i] + NTTQ) % NTTQ;
+// b[k]=a[k]s+e[k] for k < num; the shared s is lifted and transformed only once for all products
+void PQCP_POLAR_LAC_PolyAffMulti(const uint8_t *s, const uint8_t *const *a, const uint8_t *const *e, uint8_t *const *b,
+                                 const uint32_t *vecNum, uint32_t num, int32_t algId)
+{
+    uint32_t dimN = algId == PQCP_POLAR_LAC_256 ? POLAR_LAC_256_DIM : POLAR_LAC_LIGHT_128_DIM;
+    int16_t aHat[dimN], sHat[dimN];
+    PQCP_POLAR_LAC_PolyNtt(s, sHat, algId);
+    for (uint32_t k = 0; k < num; k++) {
+        PQCP_POLAR_LAC_PolyNtt(a[k], aHat, algId);
+        PQCP_POLAR_LAC_PolyAffNtt(aHat, sHat, e[k], b[k], vecNum[k], algId);
     }
 }
+
 // b=as using compact lift multiplication with constant time.
 void PQCP_POLAR_LAC_PolyMul(const uint8_t *a, const uint8_t *s, uint8_t *b, uint32_t vecNum, int32_t algId)
 {
-    uint32_t i;
-    uint32_t dimN = algId == PQCP_POLAR_LAC_256 ? 1024 : 512;
-    uint16_t a2[dimN], s2[dimN], b2[dimN];
-    uint16_t mask;
-    uint16_t a1, a2Tmp, s1, s2Tmp, b1, b2Tmp;
-
-    // step 1: map to the lifted ring with NTTQ as the modulus
-    for (i = 0; i < dimN; i++) {
-        mask = (a[i] >= q_half);
-        a1 = a[i] + Q_sub_q;
-        a2Tmp = a[i] + NTTQ;
-        a2[i] = (a1 & (-mask)) | (a2Tmp & (~(-mask)));
-    }
-
-    for (i = 0; i < dimN; i++) {
-        mask = (s[i] >= q_half);
-        s1 = s[i] + Q_sub_q;
-        s2Tmp = s[i] + NTTQ;
-        s2[i] = (s1 & (-mask)) | (s2Tmp & (~(-mask)));
-    }
-    if (algId == PQCP_POLAR_LAC_128 || algId == PQCP_POLAR_LAC_LIGHT) {
-        PQCP_POLAR_LAC_PolyMulNttLazy(a2, s2, b2);
-    } else {
-        PQCP_POLAR_LAC_PolyMulNttLazy1024(a2, s2, b2);
-    }
-    // step 3: map back to the original ring with Q as the modulus
-    for (i = 0; i < vecNum; i++) {
-        mask = (b2[i] < Q_half);
-        b1 = b2[i] + NTTQ;
-        b2Tmp = b2[i];
-        b2[i] = (b1 & (-mask)) | (b2Tmp & (~(-mask)));
-        b[i] = (b2[i] + neg_Q_mod_q) % Q;
-    }
+    uint32_t dimN = algId == PQCP_POLAR_LAC_256 ? POLAR_LAC_256_DIM : POLAR_LAC_LIGHT_128_DIM;
+    int16_t aHat[dimN], sHat[dimN];
+    PQCP_POLAR_LAC_PolyNtt(a, aHat, algId);
+    PQCP_POLAR_LAC_PolyNtt(s, sHat, algId);
+    PQCP_POLAR_LAC_PolyMulNtt(aHat, sHat, b, vecNum, algId);
 }
 
 // b=as+e using compact lift multiplication with constant time.
 void PQCP_POLAR_LAC_PolyAff(const uint8_t *a, const uint8_t *s, uint8_t *e, uint8_t *b, uint32_t vecNum, int32_t algId)
 {
-    uint32_t i;
-    uint32_t dimN = algId == PQCP_POLAR_LAC_256 ? 1024 : 512;
-    uint16_t a2[dimN], s2[dimN], b2[dimN];
-
-    uint16_t mask;
-    uint16_t a1, a2Tmp, s1, s2Tmp, b1, b2Tmp;
-    for (i = 0; i < dimN; i++) {
-        mask = (a[i] >= q_half);
-        a1 = a[i] + Q_sub_q;
-        a2Tmp = a[i] + NTTQ;
-        a2[i] = (a1 & (-mask)) | (a2Tmp & (~(-mask)));
-    }
-
-    for (i = 0; i < dimN; i++) {
-        mask = (s[i] >= q_half);
-        s1 = s[i] + Q_sub_q;
-        s2Tmp = s[i] + NTTQ;
-        s2[i] = (s1 & (-mask)) | (s2Tmp & (~(-mask)));
-    }
-    if (algId == PQCP_POLAR_LAC_LIGHT || algId == PQCP_POLAR_LAC_128) {
-        PQCP_POLAR_LAC_PolyMulNttLazy(a2, s2, b2);
-    } else {
-        PQCP_POLAR_LAC_PolyMulNttLazy1024(a2, s2, b2);
-    }
-
-    for (i = 0; i < vecNum; i++) {
-        mask = (b2[i] < Q_half);
-        b1 = b2[i] + NTTQ;
-        b2Tmp = b2[i];
-        b2[i] = (b1 & (-mask)) | (b2Tmp & (~(-mask)));
-        b2[i] = (b2[i] + neg_Q_mod_q) % Q;
-        b[i] = (b2[i] + e[i] + Q) % Q;
-    }
+    uint32_t dimN = algId == PQCP_POLAR_LAC_256 ? POLAR_LAC_256_DIM : POLAR_LAC_LIGHT_128_DIM;
+    int16_t aHat[dimN], sHat[dimN];
+    PQCP_POLAR_LAC_PolyNtt(a, aHat, algId);
+    PQCP_POLAR_LAC_PolyNtt(s, sHat, algId);
+    PQCP_POLAR_LAC_PolyAffNtt(aHat, sHat, e, b, vecNum, algId);
 }
 
 // Compression: c1 discards 1-bit
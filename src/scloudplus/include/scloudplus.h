@@ -18,15 +18,84 @@
 
 #include <stdint.h>
 #include "bsl_params.h"
+#include "crypt_eal_md.h"
+#include "pqcp_types.h"
 
 typedef struct SCLOUDPLUSPara SCLOUDPLUS_Para;
+typedef struct SCLOUDPLUSKernels SCLOUDPLUS_Kernels;
+
+// 矩阵A缓存：保存由seedA展开的矩阵A前rowNum行，同一公钥重复封装时跳过AES展开
+typedef struct {
+    uint32_t budget;   // 缓存可占用的最大字节数，0表示不缓存
+    uint32_t rowNum;   // 已展开的行数，为0时缓存无效
+    uint16_t *rows;
+    uint8_t seedA[16];
+} SCLOUDPLUS_MatrixACache;
+
+// 按缓存行对齐的缓冲区，data为NULL表示尚未填充
+typedef struct {
+    void *mem;      // 实际分配的内存，释放时使用
+    uint16_t *data; // mem中对齐后的起始位置
+    uint32_t size;  // mem的字节数
+} SCLOUDPLUS_AlignedBuf;
+
+// 预处理密钥：首次使用时由打包的密钥解出，之后的封装/解封装只需计算随机化部分
+typedef struct {
+    SCLOUDPLUS_AlignedBuf pkB;  // publicKey解包得到的B（m * nbar）
+    SCLOUDPLUS_AlignedBuf skB;  // 私钥中内嵌公钥解包得到的B，供解封装重加密使用
+    SCLOUDPLUS_AlignedBuf S;    // 解包并校验后的私钥S（nbar * n），释放前清零
+} SCLOUDPLUS_PreparedKey;
+
+// 运算缓冲区：首次运算时按参数集一次分配，各次密钥生成/封装/解封装复用，每次运算结束后清零
+typedef struct {
+    SCLOUDPLUS_AlignedBuf mem;
+    uint16_t *pool;           // 当次运算的矩阵
+    uint16_t *tmp;            // 矩阵运算与采样的临时空间
+    SCLOUDPLUS_AlignedBuf batch; // 批量封装各密文的E1与S1，首次批量封装时分配
+    CRYPT_EAL_MdCtx *shake256;
+    CRYPT_EAL_MdCtx *sha3512;
+} SCLOUDPLUS_Scratch;
+
+// 并行模式：矩阵乘法按矩阵A的8行块划分为cfg.taskNum个任务，交由调用者提供的parallelFor执行
+typedef struct {
+    PQCP_ParallelCfg cfg;
+    SCLOUDPLUS_AlignedBuf mem; // 各任务的临时空间与部分和，首次并行运算时分配，每次运算结束后清零
+} SCLOUDPLUS_Parallel;
+
+/*
+ * 确定性种子：由ctrl设置，下一次密钥生成/封装使用一次后清零，未设置时从随机数生成器获取。
+ * 密钥生成依次使用z与alpha，封装使用m（前ss字节）。
+ */
+typedef struct {
+    uint8_t z[32];
+    uint8_t alpha[32];
+    uint8_t m[32];
+    uint8_t keygenSet;
+    uint8_t encapsSet;
+} SCLOUDPLUS_Seed;
+
+// 预计算密文池：空闲时由PQCP_SCLOUDPLUS_FillEncapsPool针对当前公钥填充，封装时直接取出一组，公钥变化时清空
+typedef struct {
+    uint32_t capacity; // 最多保存的组数，0表示不使用
+    uint32_t num;      // 当前可用的组数
+    uint8_t *ct;       // capacity个密文，其后紧接capacity个共享密钥，释放前清零
+    uint8_t *ss;
+} SCLOUDPLUS_EncapsPool;
 
 // 密钥管理上下文结构
 typedef struct {
     // 可根据需要添加成员变量
-    SCLOUDPLUS_Para *para;
+    const SCLOUDPLUS_Para *para;
+    const SCLOUDPLUS_Kernels *kernels; // 设置参数集时按参数集选择
     uint8_t *publicKey;
     uint8_t *privateKey;
+    SCLOUDPLUS_MatrixACache matrixA;
+    uint8_t hpk[32]; // H(pk)，在设置公钥或生成密钥时计算，publicKey非空时有效
+    SCLOUDPLUS_PreparedKey prepared;
+    SCLOUDPLUS_Scratch scratch;
+    SCLOUDPLUS_Parallel parallel;
+    SCLOUDPLUS_Seed seed;
+    SCLOUDPLUS_EncapsPool encapsPool;
 } SCLOUDPLUS_Ctx;
 
 // 函数声明
@@ -49,5 +118,20 @@ int32_t PQCP_SCLOUDPLUS_Encaps(SCLOUDPLUS_Ctx *ctx,
 int32_t PQCP_SCLOUDPLUS_Decaps(SCLOUDPLUS_Ctx *ctx,
                               const uint8_t *ciphertext, uint32_t ctLen,
                               uint8_t *sharedSecret, uint32_t *ssLen);
+/*
+ * 批量封装：对同一公钥生成num个密文与共享密钥，矩阵A每批只展开一次。
+ * 第i个密文位于ciphertext + i * 密文长度，第i个共享密钥位于sharedSecret + i * 共享密钥长度；
+ * *ctLen、*ssLen输入为缓冲区总长度，输出为实际写入的总长度。
+ * 随机数的消耗顺序与依次调用num次PQCP_SCLOUDPLUS_Encaps相同。
+ */
+int32_t PQCP_SCLOUDPLUS_EncapsBatch(SCLOUDPLUS_Ctx *ctx, uint32_t num,
+                                   uint8_t *ciphertext, uint32_t *ctLen,
+                                   uint8_t *sharedSecret, uint32_t *ssLen);
+/*
+ * 预计算密文池：按PQCP_SCLOUDPLUS_SET_ENCAPS_POOL设置的容量，为当前公钥最多新增maxNum组密文与共享密钥。
+ * 可在空闲时分多次调用，也可经ctrl命令PQCP_SCLOUDPLUS_FILL_ENCAPS_POOL调用；之后的PQCP_SCLOUDPLUS_Encaps
+ * 在池非空时直接取出一组。不可与同一上下文的其他操作并发调用。
+ */
+int32_t PQCP_SCLOUDPLUS_FillEncapsPool(SCLOUDPLUS_Ctx *ctx, uint32_t maxNum);
 
 #endif // SCLOUDPLUS_H
\ No newline at end of file
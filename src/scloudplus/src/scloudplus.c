@@ -25,202 +25,488 @@
 #include "pqcp_types.h"
 #include "scloudplus_local.h"
 
-// 预定义三组参数配置
-static SCLOUDPLUS_Para PRESET_PARAS[] = {
-    {
-        .ss = 16,
-        .mbar = 8,
-        .nbar = 8,
-        .m = 600,
-        .n = 600,
-        .logq = 12,
-        .logq1 = 9,
-        .logq2 = 7,
-        .h1 = 150,
-        .h2 = 150,
-        .eta1 = 7,
-        .eta2 = 7,
-        .mu = 64,
-        .muConut = 2,
-        .tau = 3,
-        .mnin = 679,
-        .mnout = 582,
-        .c1Size = 5400,
-        .c2Size = 56,
-        .ctxSize = 5456,
-        .pkSize = 7216,
-        .pkeSkSize = 1200,
-        .kemSkSize = 8480
-    },
-    {   
-        .ss = 24,
-        .mbar = 8,
-        .nbar = 8,
-        .m = 928,
-        .n = 896,
-        .logq = 12,
-        .logq1 = 12,
-        .logq2 = 10,
-        .h1 = 224,
-        .h2 = 232,
-        .eta1 = 2,
-        .eta2 = 1,
-        .mu = 96,
-        .muConut = 2,
-        .tau = 4,
-        .mnin = 671,
-        .mnout = 488,
-        .c1Size = 10752,
-        .c2Size = 80,
-        .ctxSize = 10832,
-        .pkSize = 11152,
-        .pkeSkSize = 1792,
-        .kemSkSize = 13008
-    },
-    {
-        .ss = 32,
-        .mbar = 12,
-        .nbar = 11,
-        .m = 1136,
-        .n = 1120,
-        .logq = 12,
-        .logq1 = 10,
-        .logq2 = 7,
-        .h1 = 280,
-        .h2 = 284,
-        .eta1 = 3,
-        .eta2 = 2,
-        .mu = 64,
-        .muConut = 4,
-        .tau = 3,
-        .mnin = 680,
-        .mnout = 530,
-        .c1Size = 16800,
-        .c2Size = 116,
-        .ctxSize = 16916,
-        .pkSize = 18760,
-        .pkeSkSize = 3080,
-        .kemSkSize = 21904
-    }
-};
-
-static int32_t SCLOUDPLUS_PKEKeygen(const SCLOUDPLUS_Para *para, uint8_t *pk, uint8_t *sk)
+static void SCLOUDPLUS_AlignedBufFree(SCLOUDPLUS_AlignedBuf *buf)
 {
+    if (buf->mem != NULL) {
+        BSL_SAL_ClearFree(buf->mem, buf->size);
+    }
+    buf->mem = NULL;
+    buf->data = NULL;
+    buf->size = 0;
+}
+
+static void SCLOUDPLUS_FreePreparedKey(SCLOUDPLUS_PreparedKey *prepared)
+{
+    SCLOUDPLUS_AlignedBufFree(&prepared->pkB);
+    SCLOUDPLUS_AlignedBufFree(&prepared->skB);
+    SCLOUDPLUS_AlignedBufFree(&prepared->S);
+}
+
+// 释放封装池中的密文与共享密钥
+static void SCLOUDPLUS_EncapsPoolFree(SCLOUDPLUS_EncapsPool *pool, const SCLOUDPLUS_Para *para)
+{
+    if (pool->ct != NULL) {
+        BSL_SAL_ClearFree(pool->ct, pool->capacity * (para->ctxSize + para->ss));
+    }
+    pool->ct = NULL;
+    pool->ss = NULL;
+    pool->num = 0;
+}
+
+// 清空池中已有的密文与共享密钥，保留已分配的空间
+static void SCLOUDPLUS_EncapsPoolReset(SCLOUDPLUS_EncapsPool *pool, const SCLOUDPLUS_Para *para)
+{
+    if (pool->num != 0) {
+        BSL_SAL_CleanseData(pool->ss, pool->num * para->ss);
+        pool->num = 0;
+    }
+}
+
+// 分配len字节并返回按SCLOUDPLUS_ALIGN对齐的起始位置，填充完成后由调用者设置buf->data
+static uint16_t *SCLOUDPLUS_AlignedBufAlloc(SCLOUDPLUS_AlignedBuf *buf, const uint32_t len)
+{
+    buf->mem = BSL_SAL_Malloc(len + SCLOUDPLUS_ALIGN - 1);
+    if (buf->mem == NULL) {
+        return NULL;
+    }
+    buf->size = len + SCLOUDPLUS_ALIGN - 1;
+    uintptr_t addr = ((uintptr_t)buf->mem + SCLOUDPLUS_ALIGN - 1) & ~(uintptr_t)(SCLOUDPLUS_ALIGN - 1);
+    return (uint16_t *)addr;
+}
+
+// 首次使用时解包公钥B并缓存；pk为publicKey或私钥中内嵌的公钥
+static const uint16_t *SCLOUDPLUS_PrepareB(const SCLOUDPLUS_Ctx *ctx, const uint8_t *pk, SCLOUDPLUS_AlignedBuf *buf)
+{
+    const SCLOUDPLUS_Para *para = ctx->para;
+    if (buf->data != NULL) {
+        return buf->data;
+    }
+    uint16_t *B = SCLOUDPLUS_AlignedBufAlloc(buf, para->m * para->nbar * sizeof(uint16_t));
+    if (B == NULL) {
+        return NULL;
+    }
+    ctx->kernels->unPackPK(pk, para, B);
+    buf->data = B;
+    return B;
+}
+
+// 首次使用时解包私钥S并缓存，缓存前校验S的取值与每行非零元个数
+static int32_t SCLOUDPLUS_PrepareS(const SCLOUDPLUS_Ctx *ctx, const uint8_t *sk, SCLOUDPLUS_AlignedBuf *buf)
+{
+    const SCLOUDPLUS_Para *para = ctx->para;
+    if (buf->data != NULL) {
+        return PQCP_SUCCESS;
+    }
+    uint16_t *S = SCLOUDPLUS_AlignedBufAlloc(buf, para->n * para->nbar * sizeof(uint16_t));
+    if (S == NULL) {
+        return PQCP_MEM_ALLOC_FAIL;
+    }
+    ctx->kernels->unPackSK(sk, para, S);
+    int32_t ret = SCLOUDPLUS_TernaryCheck(S, para->nbar, para->n, para->h1);
+    if (ret != PQCP_SUCCESS) {
+        SCLOUDPLUS_AlignedBufFree(buf);
+        return ret;
+    }
+    buf->data = S;
+    return PQCP_SUCCESS;
+}
+
+#define SCLOUDPLUS_ALIGN_U16(x) (((x) + SCLOUDPLUS_ALIGN / 2 - 1) & ~(uint32_t)(SCLOUDPLUS_ALIGN / 2 - 1))
+
+// 各运算所需矩阵空间的最大值（uint16_t个数）
+static uint32_t SCLOUDPLUS_PoolLen(const SCLOUDPLUS_Para *para)
+{
+    // 密钥生成：S、E、B
+    uint32_t len = (para->n + 2 * para->m) * para->nbar;
+    // 加密：S1、E2、mu0、C2、E1（原位得到C1）
+    const uint32_t encLen = para->mbar * (para->m + para->n + 3 * para->nbar);
+    // 解密：C1、C2、D
+    const uint32_t decLen = para->mbar * (para->n + 2 * para->nbar);
+    len = (encLen > len) ? encLen : len;
+    len = (decLen > len) ? decLen : len;
+    return len;
+}
+
+/*
+ * 首次运算时分配运算缓冲区：[重加密密文 | 矩阵 | 临时空间]，并创建复用的摘要上下文；
+ * 之后同一上下文上的运算不再申请堆内存。
+ */
+static int32_t SCLOUDPLUS_ScratchInit(SCLOUDPLUS_Ctx *ctx)
+{
+    SCLOUDPLUS_Scratch *scratch = &ctx->scratch;
+    if (scratch->mem.data != NULL) {
+        return PQCP_SUCCESS;
+    }
+    const SCLOUDPLUS_Para *para = ctx->para;
+    if (scratch->shake256 == NULL) {
+        scratch->shake256 = CRYPT_EAL_MdNewCtx(CRYPT_MD_SHAKE256);
+        if (scratch->shake256 == NULL) {
+            return PQCP_MEM_ALLOC_FAIL;
+        }
+    }
+    if (scratch->sha3512 == NULL) {
+        scratch->sha3512 = CRYPT_EAL_MdNewCtx(CRYPT_MD_SHA3_512);
+        if (scratch->sha3512 == NULL) {
+            return PQCP_MEM_ALLOC_FAIL;
+        }
+    }
+    const uint32_t poolLen = SCLOUDPLUS_ALIGN_U16(SCLOUDPLUS_PoolLen(para));
+    const uint32_t tmpLen = SCLOUDPLUS_KernelTmpLen(para);
+    uint16_t *buf = SCLOUDPLUS_AlignedBufAlloc(&scratch->mem, (poolLen + tmpLen) * sizeof(uint16_t));
+    if (buf == NULL) {
+        return PQCP_MEM_ALLOC_FAIL;
+    }
+    scratch->pool = buf;
+    scratch->tmp = buf + poolLen;
+    scratch->mem.data = buf;
+    return PQCP_SUCCESS;
+}
+
+static void SCLOUDPLUS_ScratchCleanse(SCLOUDPLUS_Scratch *scratch)
+{
+    if (scratch->mem.mem != NULL) {
+        BSL_SAL_CleanseData(scratch->mem.mem, scratch->mem.size);
+    }
+}
+
+static void SCLOUDPLUS_ScratchFree(SCLOUDPLUS_Scratch *scratch)
+{
+    SCLOUDPLUS_AlignedBufFree(&scratch->mem);
+    SCLOUDPLUS_AlignedBufFree(&scratch->batch);
+    scratch->pool = NULL;
+    scratch->tmp = NULL;
+    CRYPT_EAL_MdFreeCtx(scratch->shake256);
+    scratch->shake256 = NULL;
+    CRYPT_EAL_MdFreeCtx(scratch->sha3512);
+    scratch->sha3512 = NULL;
+}
+
+// 批量封装缓冲区：[E1 * SCLOUDPLUS_ENCAPS_BATCH_MAX | S1 * SCLOUDPLUS_ENCAPS_BATCH_MAX]
+static int32_t SCLOUDPLUS_BatchInit(SCLOUDPLUS_Ctx *ctx)
+{
+    SCLOUDPLUS_AlignedBuf *batch = &ctx->scratch.batch;
+    if (batch->data != NULL) {
+        return PQCP_SUCCESS;
+    }
+    const SCLOUDPLUS_Para *para = ctx->para;
+    const uint32_t slotLen = para->mbar * (para->n + para->m);
+    uint16_t *buf = SCLOUDPLUS_AlignedBufAlloc(batch, SCLOUDPLUS_ENCAPS_BATCH_MAX * slotLen * sizeof(uint16_t));
+    if (buf == NULL) {
+        return PQCP_MEM_ALLOC_FAIL;
+    }
+    batch->data = buf;
+    return PQCP_SUCCESS;
+}
+
+// 并行任务共享的参数，任务idx负责矩阵A的第[rowBegin, rowEnd)行
+typedef struct {
+    SCLOUDPLUS_Ctx *ctx;
+    const uint8_t *seedA;
+    const uint16_t *S;
+    uint16_t *out; // AS_E为B，SA_E为E
+    uint32_t tmpLen;
+    uint32_t partLen;
+    int32_t ret[SCLOUDPLUS_PARALLEL_MAX];
+} SCLOUDPLUS_ParallelJob;
+
+static void SCLOUDPLUS_ParallelRange(const SCLOUDPLUS_ParallelJob *job, const uint32_t idx, uint32_t *rowBegin,
+    uint32_t *rowEnd)
+{
+    const uint32_t blocks = job->ctx->para->m / SCLOUDPLUS_SA_E_ROWS;
+    const uint32_t taskNum = job->ctx->parallel.cfg.taskNum;
+    *rowBegin = (idx * blocks / taskNum) * SCLOUDPLUS_SA_E_ROWS;
+    *rowEnd = ((idx + 1) * blocks / taskNum) * SCLOUDPLUS_SA_E_ROWS;
+}
+
+// 任务idx的空间：[临时空间 | 部分和]
+static uint16_t *SCLOUDPLUS_ParallelMem(const SCLOUDPLUS_ParallelJob *job, const uint32_t idx)
+{
+    return job->ctx->parallel.mem.data + idx * (job->tmpLen + job->partLen);
+}
+
+// B的各行互不重叠，各任务直接写入B
+static void SCLOUDPLUS_AS_E_Task(void *arg, uint32_t idx)
+{
+    SCLOUDPLUS_ParallelJob *job = (SCLOUDPLUS_ParallelJob *)arg;
+    uint32_t rowBegin;
+    uint32_t rowEnd;
+    SCLOUDPLUS_ParallelRange(job, idx, &rowBegin, &rowEnd);
+    job->ret[idx] = job->ctx->kernels->asERows(job->seedA, job->S, job->ctx->para, rowBegin, rowEnd, job->out,
+        SCLOUDPLUS_ParallelMem(job, idx));
+}
+
+// 各行块都累加到E的全部元素，任务0直接累加到E，其余任务累加到各自的部分和，完成后按任务顺序相加
+static void SCLOUDPLUS_SA_E_Task(void *arg, uint32_t idx)
+{
+    SCLOUDPLUS_ParallelJob *job = (SCLOUDPLUS_ParallelJob *)arg;
+    const SCLOUDPLUS_Ctx *ctx = job->ctx;
+    uint16_t *tmp = SCLOUDPLUS_ParallelMem(job, idx);
+    uint16_t *E = job->out;
+    uint32_t rowBegin;
+    uint32_t rowEnd;
+    SCLOUDPLUS_ParallelRange(job, idx, &rowBegin, &rowEnd);
+    if (idx != 0) {
+        E = tmp + job->tmpLen;
+        memset(E, 0, ctx->para->mbar * ctx->para->n * sizeof(uint16_t));
+    }
+    job->ret[idx] = ctx->kernels->saERows(job->seedA, ctx->matrixA.rows, ctx->matrixA.rowNum, 1, job->S, E,
+        ctx->para, rowBegin, rowEnd, tmp);
+}
+
+/*
+ * 将矩阵乘法按矩阵A的行块交由调用者的parallelFor执行。模2^16加法与顺序无关，
+ * 结果与任务的执行线程及顺序无关，和串行计算一致。
+ */
+static int32_t SCLOUDPLUS_ParallelRun(SCLOUDPLUS_Ctx *ctx, PQCP_ParallelTask task, SCLOUDPLUS_ParallelJob *job)
+{
+    const PQCP_ParallelCfg *cfg = &ctx->parallel.cfg;
+    const SCLOUDPLUS_Para *para = ctx->para;
+    job->ctx = ctx;
+    job->tmpLen = SCLOUDPLUS_ALIGN_U16(SCLOUDPLUS_KernelTmpLen(para));
+    job->partLen = SCLOUDPLUS_ALIGN_U16(para->mbar * para->n);
+    SCLOUDPLUS_AlignedBuf *mem = &ctx->parallel.mem;
+    if (mem->data == NULL) {
+        const uint32_t len = cfg->taskNum * (job->tmpLen + job->partLen) * sizeof(uint16_t);
+        uint16_t *buf = SCLOUDPLUS_AlignedBufAlloc(mem, len);
+        if (buf == NULL) {
+            return PQCP_MEM_ALLOC_FAIL;
+        }
+        mem->data = buf;
+    }
+    for (uint32_t i = 0; i < cfg->taskNum; i++) {
+        job->ret[i] = PQCP_SCLOUDPLUS_PARALLEL_FAIL; // 未被执行的任务视为失败
+    }
+    int32_t ret = cfg->parallelFor(cfg->pool, cfg->taskNum, task, job);
+    if (ret != PQCP_SUCCESS) {
+        goto EXIT;
+    }
+    for (uint32_t i = 0; i < cfg->taskNum; i++) {
+        if (job->ret[i] != PQCP_SUCCESS) {
+            ret = job->ret[i];
+            goto EXIT;
+        }
+    }
+    if (task == SCLOUDPLUS_SA_E_Task) {
+        for (uint32_t i = 1; i < cfg->taskNum; i++) {
+            uint16_t *part = SCLOUDPLUS_ParallelMem(job, i) + job->tmpLen;
+            SCLOUDPLUS_Add(job->out, part, para->mbar * para->n, job->out);
+        }
+    }
+EXIT:
+    BSL_SAL_CleanseData(mem->mem, mem->size);
+    return ret;
+}
+
+// 计算B = A * S + E
+static int32_t SCLOUDPLUS_MatrixAS_E(SCLOUDPLUS_Ctx *ctx, const uint8_t *seedA, const uint16_t *S,
+    const uint16_t *E, uint16_t *B)
+{
+    memcpy(B, E, ctx->para->m * ctx->para->nbar * sizeof(uint16_t));
+    if (ctx->parallel.cfg.parallelFor == NULL) {
+        return ctx->kernels->asERows(seedA, S, ctx->para, 0, ctx->para->m, B, ctx->scratch.tmp);
+    }
+    SCLOUDPLUS_ParallelJob job = {.seedA = seedA, .S = S, .out = B};
+    return SCLOUDPLUS_ParallelRun(ctx, SCLOUDPLUS_AS_E_Task, &job);
+}
+
+// 计算E = S * A + E（单个密文）
+static int32_t SCLOUDPLUS_MatrixSA_E(SCLOUDPLUS_Ctx *ctx, const uint8_t *seedA, const uint16_t *S, uint16_t *E)
+{
+    if (ctx->parallel.cfg.parallelFor == NULL) {
+        return ctx->kernels->saERows(seedA, ctx->matrixA.rows, ctx->matrixA.rowNum, 1, S, E, ctx->para, 0,
+            ctx->para->m, ctx->scratch.tmp);
+    }
+    SCLOUDPLUS_ParallelJob job = {.seedA = seedA, .S = S, .out = E};
+    return SCLOUDPLUS_ParallelRun(ctx, SCLOUDPLUS_SA_E_Task, &job);
+}
+
+// 取出ctrl设置的确定性种子，未设置时调用随机数生成器；种子只使用一次
+static int32_t SCLOUDPLUS_Randbytes(uint8_t *seed, const uint8_t seedSet, uint8_t *out, const uint32_t len)
+{
+    if (seedSet == 0) {
+        return CRYPT_EAL_Randbytes(out, len);
+    }
+    memcpy(out, seed, len);
+    BSL_SAL_CleanseData(seed, len);
+    return PQCP_SUCCESS;
+}
+
+static int32_t SCLOUDPLUS_PKEKeygen(SCLOUDPLUS_Ctx *keyCtx, const uint8_t *alpha, uint8_t *pk, uint8_t *sk)
+{
+    const SCLOUDPLUS_Para *para = keyCtx->para;
     if (para->ss == 0 || pk == NULL || sk == NULL) {
         return PQCP_NULL_INPUT;
     }
     int32_t ret;
-    uint16_t *memoryPool = BSL_SAL_Malloc(sizeof(uint16_t) * ((para->n + 2 * para->m) * para->nbar));
-    if (memoryPool == NULL) {
-        return PQCP_MEM_ALLOC_FAIL;
-    }
+    uint16_t *memoryPool = keyCtx->scratch.pool;
     uint16_t *S = memoryPool;
     uint16_t *E = memoryPool + (para->n * para->nbar);
     uint16_t *B = memoryPool + (para->n * para->nbar) + (para->m * para->nbar);
     
     uint32_t seedLen = SCLOUDPLUS_SEED_A_LEN + SCLOUDPLUS_SEED_R1_LEN + SCLOUDPLUS_SEED_R2_LEN;
-    uint8_t alpha[SCLOUDPLUS_ALPHA_LEN], seed[seedLen];
+    uint8_t seed[seedLen];
     const uint8_t *seedA = seed;
     const uint8_t *r1 = seed + SCLOUDPLUS_SEED_A_LEN;
     const uint8_t *r2 = seed + SCLOUDPLUS_SEED_A_LEN + SCLOUDPLUS_SEED_R1_LEN;
-    ret = CRYPT_EAL_Randbytes(alpha, SCLOUDPLUS_ALPHA_LEN);
-    if (ret != PQCP_SUCCESS) {
-        goto EXIT;
-    }
-    ret = SCLOUDPLUS_MdFunc(CRYPT_MD_SHAKE256, alpha, SCLOUDPLUS_ALPHA_LEN, NULL, 0, seed, &seedLen);
+    ret = SCLOUDPLUS_MdCtxFunc(keyCtx->scratch.shake256, alpha, SCLOUDPLUS_ALPHA_LEN, NULL, 0, seed, &seedLen);
     if (ret != PQCP_SUCCESS) {
         goto EXIT;
     }
-    ret = SCLOUDPLUS_SamplePsi(r1, para, S);
+    ret = SCLOUDPLUS_SamplePsi(r1, para, keyCtx->scratch.shake256, S);
     if (ret != PQCP_SUCCESS) {
         goto EXIT;
     }
-    ret = SCLOUDPLUS_SampleEta1(r2, para, E);
+    ret = SCLOUDPLUS_SampleEta1(r2, para, keyCtx->scratch.shake256, E);
     if (ret != PQCP_SUCCESS) {
         goto EXIT;
     }
-    ret = SCLOUDPLUS_AS_E(seedA, S, E, para, B);
+    ret = SCLOUDPLUS_MatrixAS_E(keyCtx, seedA, S, E, B);
     if (ret != PQCP_SUCCESS) {
         goto EXIT;
     }
-    SCLOUDPLUS_PackPK(B, para, pk);
+    keyCtx->kernels->packPK(B, para, pk);
     memcpy(pk + para->pkSize - SCLOUDPLUS_SEED_A_LEN, seedA, SCLOUDPLUS_SEED_A_LEN);
-    SCLOUDPLUS_PackSK(S, para, sk);
+    keyCtx->kernels->packSK(S, para, sk);
 EXIT:
-    BSL_SAL_FREE(memoryPool);
+    BSL_SAL_CleanseData(seed, sizeof(seed));
     return ret;
 }
 
-static int32_t SCLOUDPLUS_PKEEncrypt(const uint8_t *pk, const uint8_t *m, const uint8_t *r, const SCLOUDPLUS_Para *para,
-    uint8_t *ctx)
+// 按预算展开并缓存seedA对应的矩阵A，缓存已对应该seedA时直接返回
+static int32_t SCLOUDPLUS_LoadMatrixA(SCLOUDPLUS_Ctx *ctx, const uint8_t *seedA)
 {
-    int32_t ret;
-    uint16_t *memoryPool =  BSL_SAL_Malloc(
-            sizeof(uint16_t) * ((para->mbar * (para->m + 2 * para->n + 3 * para->nbar)) + (para->m * para->nbar)));
-    if (memoryPool == NULL) {
-        return PQCP_MEM_ALLOC_FAIL;
+    SCLOUDPLUS_MatrixACache *cache = &ctx->matrixA;
+    const SCLOUDPLUS_Para *para = ctx->para;
+    if (cache->budget == 0) {
+        return PQCP_SUCCESS;
+    }
+    if (cache->rowNum != 0 && memcmp(cache->seedA, seedA, SCLOUDPLUS_SEED_A_LEN) == 0) {
+        return PQCP_SUCCESS;
+    }
+    uint32_t rowNum = cache->budget / (para->n * sizeof(uint16_t));
+    rowNum = (rowNum > para->m) ? para->m : (rowNum - rowNum % SCLOUDPLUS_SA_E_ROWS);
+    if (rowNum == 0) {
+        return PQCP_SUCCESS;
+    }
+    cache->rowNum = 0;
+    if (cache->rows == NULL) {
+        cache->rows = BSL_SAL_Malloc(rowNum * para->n * sizeof(uint16_t));
+        if (cache->rows == NULL) {
+            return PQCP_MEM_ALLOC_FAIL;
+        }
     }
-    uint16_t *S1 = memoryPool;
-    uint16_t *E1 = memoryPool + para->mbar * para->m;
-    uint16_t *E2 = memoryPool + para->mbar * (para->m + para->n);
-    uint16_t *mu0 = memoryPool + para->mbar * (para->m + para->n + para->nbar);
-    uint16_t *C1 = memoryPool + para->mbar * (para->m + para->n + 2 * para->nbar);
-    uint16_t *C2 = memoryPool + para->mbar * (para->m + 2 * para->n + 2 * para->nbar);
-    uint16_t *B = memoryPool + para->mbar * (para->m + 2 * para->n + 3 * para->nbar);
+    int32_t ret = SCLOUDPLUS_ExpandA(seedA, para, rowNum, cache->rows, ctx->scratch.tmp);
+    if (ret != PQCP_SUCCESS) {
+        return ret;
+    }
+    memcpy(cache->seedA, seedA, SCLOUDPLUS_SEED_A_LEN);
+    cache->rowNum = rowNum;
+    return PQCP_SUCCESS;
+}
+
+static void SCLOUDPLUS_FreeMatrixA(SCLOUDPLUS_MatrixACache *cache)
+{
+    BSL_SAL_FREE(cache->rows);
+    cache->rowNum = 0;
+}
+
+/*
+ * 密文去向：out非NULL时写出打包后的密文；否则（解封装重加密）将打包结果逐块与expect比较，
+ * 差异按位或累积到diff，不保存重加密的密文，比较过程与数据无关
+ */
+typedef struct {
+    uint8_t *out;
+    const uint8_t *expect;
+    uint8_t diff;
+} SCLOUDPLUS_CtSink;
+
+/*
+ * 加密前半部分：由r采样S1、E1、E2，计算C2 = S1 * B + E2 + mu0并压缩打包至密文，
+ * 留下S1（mbar * m）与E1（mbar * n），C1 = S1 * A + E1由SA_E计算
+ */
+static int32_t SCLOUDPLUS_PKEEncryptPrepare(SCLOUDPLUS_Ctx *keyCtx, const uint16_t *B, const uint8_t *m,
+    const uint8_t *r, uint16_t *S1, uint16_t *E1, SCLOUDPLUS_CtSink *ct)
+{
+    int32_t ret;
+    const SCLOUDPLUS_Para *para = keyCtx->para;
+    uint16_t *memoryPool = keyCtx->scratch.pool; // 前mbar * m个元素留给单次加密的S1
+    uint16_t *E2 = memoryPool + para->mbar * para->m;
+    uint16_t *mu0 = memoryPool + para->mbar * (para->m + para->nbar);
+    uint16_t *C2 = memoryPool + para->mbar * (para->m + 2 * para->nbar);
     uint32_t seedLen = SCLOUDPLUS_SEED_R1_LEN + SCLOUDPLUS_SEED_R2_LEN;
     uint8_t seed[seedLen];
-    const uint8_t *seedA = pk + para->pkSize - SCLOUDPLUS_SEED_A_LEN;
     const uint8_t *r1 = seed;
     const uint8_t *r2 = seed + SCLOUDPLUS_SEED_R1_LEN;
-    ret = SCLOUDPLUS_MdFunc(CRYPT_MD_SHAKE256, r, SCLOUDPLUS_RAND_R_LEN, NULL, 0, seed, &seedLen);
+    ret = SCLOUDPLUS_MdCtxFunc(keyCtx->scratch.shake256, r, SCLOUDPLUS_RAND_R_LEN, NULL, 0, seed, &seedLen);
     if (ret != PQCP_SUCCESS) {
         goto EXIT;
     }
-    ret = SCLOUDPLUS_SamplePhi(r1, para, S1);
+    ret = SCLOUDPLUS_SamplePhi(r1, para, keyCtx->scratch.shake256, S1);
     if (ret != PQCP_SUCCESS) {
         goto EXIT;
     }
-    ret = SCLOUDPLUS_SampleEta2(r2, para, E1, E2);
+    ret = SCLOUDPLUS_SampleEta2(r2, para, keyCtx->scratch.shake256, E1, E2);
     if (ret != PQCP_SUCCESS) {
         goto EXIT;
     }
     SCLOUDPLUS_MsgEncode(m, para, mu0);
-    SCLOUDPLUS_UnPackPK(pk, para, B);
-    ret = SCLOUDPLUS_SA_E(seedA, S1, E1, para, C1);
-    if (ret != PQCP_SUCCESS) {
-        goto EXIT;
-    }
-    SCLOUDPLUS_SB_E(S1, B, E2, para, C2);
+    keyCtx->kernels->sbE(S1, B, E2, para, C2);
     SCLOUDPLUS_Add(C2, mu0, para->mbar * para->nbar, C2);
-    SCLOUDPLUS_CompressC1(C1, para, C1);
-    SCLOUDPLUS_CompressC2(C2, para, C2);
-    SCLOUDPLUS_PackC1(C1, para, ctx);
-    SCLOUDPLUS_PackC2(C2, para, ctx + para->c1Size);
+    if (ct->out != NULL) {
+        keyCtx->kernels->compressPackC2(C2, para, ct->out + para->c1Size);
+    } else {
+        ct->diff |= keyCtx->kernels->compressCmpC2(C2, para, ct->expect + para->c1Size);
+    }
 EXIT:
-    BSL_SAL_FREE(memoryPool);
+    BSL_SAL_CleanseData(seed, sizeof(seed));
     return ret;
 }
 
-static int32_t SCLOUDPLUS_PKEDecrypt(const uint8_t *sk, const uint8_t *ctx, const SCLOUDPLUS_Para *para, uint8_t *m)
+// 加密后半部分：压缩C1并打包至密文
+static void SCLOUDPLUS_PKEEncryptFinish(const SCLOUDPLUS_Ctx *keyCtx, const uint16_t *C1, SCLOUDPLUS_CtSink *ct)
 {
-    uint16_t *memoryPool = BSL_SAL_Malloc(sizeof(uint16_t) * ((para->mbar * (para->n + 2 * para->nbar)) + (para->n * para->nbar)));
-    if (memoryPool == NULL) {
-        return PQCP_MEM_ALLOC_FAIL;
+    if (ct->out != NULL) {
+        keyCtx->kernels->compressPackC1(C1, keyCtx->para, ct->out);
+    } else {
+        ct->diff |= keyCtx->kernels->compressCmpC1(C1, keyCtx->para, ct->expect);
     }
-    uint16_t *S = memoryPool;
-    uint16_t *C1 = memoryPool + para->n * para->nbar;
-    uint16_t *C2 = memoryPool + para->mbar * para->n + para->n * para->nbar;
-    uint16_t *D = memoryPool + para->mbar * (para->n + para->nbar) + para->n * para->nbar;
-    SCLOUDPLUS_UnPackSK(sk, para, S);
-    SCLOUDPLUS_UnPackC1(ctx, para, C1);
-    SCLOUDPLUS_UnPackC2(ctx + para->c1Size, para, C2);
-    SCLOUDPLUS_DeCompressC1(C1, para, C1);
-    SCLOUDPLUS_DeCompressC2(C2, para, C2);
-    SCLOUDPLUS_CS(C1, S, para, D);
+}
+
+static int32_t SCLOUDPLUS_PKEEncrypt(SCLOUDPLUS_Ctx *keyCtx, const uint8_t *pk, const uint16_t *B, const uint8_t *m,
+    const uint8_t *r, SCLOUDPLUS_CtSink *ct)
+{
+    const SCLOUDPLUS_Para *para = keyCtx->para;
+    uint16_t *E1 = keyCtx->scratch.pool + para->mbar * (para->m + 3 * para->nbar);
+    uint16_t *S1 = keyCtx->scratch.pool;
+    const uint8_t *seedA = pk + para->pkSize - SCLOUDPLUS_SEED_A_LEN;
+    int32_t ret = SCLOUDPLUS_PKEEncryptPrepare(keyCtx, B, m, r, S1, E1, ct);
+    if (ret != PQCP_SUCCESS) {
+        return ret;
+    }
+    ret = SCLOUDPLUS_LoadMatrixA(keyCtx, seedA);
+    if (ret != PQCP_SUCCESS) {
+        return ret;
+    }
+    ret = SCLOUDPLUS_MatrixSA_E(keyCtx, seedA, S1, E1);
+    if (ret != PQCP_SUCCESS) {
+        return ret;
+    }
+    SCLOUDPLUS_PKEEncryptFinish(keyCtx, E1, ct);
+    return PQCP_SUCCESS;
+}
+
+static int32_t SCLOUDPLUS_PKEDecrypt(SCLOUDPLUS_Ctx *keyCtx, const uint16_t *S, const uint8_t *ctx, uint8_t *m)
+{
+    const SCLOUDPLUS_Para *para = keyCtx->para;
+    uint16_t *memoryPool = keyCtx->scratch.pool;
+    uint16_t *C1 = memoryPool;
+    uint16_t *C2 = memoryPool + para->mbar * para->n;
+    uint16_t *D = memoryPool + para->mbar * (para->n + para->nbar);
+    keyCtx->kernels->unPackDeCompressC1(ctx, para, C1);
+    keyCtx->kernels->unPackDeCompressC2(ctx + para->c1Size, para, C2);
+    keyCtx->kernels->cs(C1, S, para, D, keyCtx->scratch.tmp);
     SCLOUDPLUS_Sub(C2, D, para->mbar * para->nbar, D);
-    int32_t ret = SCLOUDPLUS_MsgDecode(D, para, m);
-    BSL_SAL_FREE(memoryPool);
-    return ret;
+    return SCLOUDPLUS_MsgDecode(D, para, m);
 }
 
 void *PQCP_SCLOUDPLUS_NewCtx(void)
@@ -239,12 +525,18 @@ int32_t PQCP_SCLOUDPLUS_Gen(SCLOUDPLUS_Ctx *ctx)
     if (ctx == NULL || ctx->para == NULL) {
         return PQCP_NULL_INPUT;
     }
+    int32_t ret = SCLOUDPLUS_ScratchInit(ctx);
+    if (ret != PQCP_SUCCESS) {
+        return ret;
+    }
     if (ctx->publicKey != NULL) {
         BSL_SAL_FREE(ctx->publicKey);
     }
     if (ctx->privateKey != NULL) {
         BSL_SAL_ClearFree(ctx->privateKey, ctx->para->kemSkSize);
     }
+    SCLOUDPLUS_FreePreparedKey(&ctx->prepared);
+    SCLOUDPLUS_EncapsPoolReset(&ctx->encapsPool, ctx->para);
     ctx->publicKey = BSL_SAL_Calloc(ctx->para->pkSize, sizeof(uint8_t));
     if (ctx->publicKey == NULL) {
         return PQCP_MEM_ALLOC_FAIL;
@@ -255,24 +547,36 @@ int32_t PQCP_SCLOUDPLUS_Gen(SCLOUDPLUS_Ctx *ctx)
     }
     uint32_t outLen = SCLOUDPLUS_HPK_LEN;
     uint8_t z[SCLOUDPLUS_RAND_Z_LEN];
-    int32_t ret = CRYPT_EAL_Randbytes(z, SCLOUDPLUS_RAND_Z_LEN);
+    uint8_t alpha[SCLOUDPLUS_ALPHA_LEN];
+    const uint8_t seedSet = ctx->seed.keygenSet;
+    ctx->seed.keygenSet = 0;
+    ret = SCLOUDPLUS_Randbytes(ctx->seed.z, seedSet, z, SCLOUDPLUS_RAND_Z_LEN);
     if (ret != PQCP_SUCCESS) {
-        return ret;
+        goto EXIT;
+    }
+    ret = SCLOUDPLUS_Randbytes(ctx->seed.alpha, seedSet, alpha, SCLOUDPLUS_ALPHA_LEN);
+    if (ret != PQCP_SUCCESS) {
+        goto EXIT;
     }
-    ret = SCLOUDPLUS_PKEKeygen(ctx->para, ctx->publicKey, ctx->privateKey);
+    ret = SCLOUDPLUS_PKEKeygen(ctx, alpha, ctx->publicKey, ctx->privateKey);
     if (ret != PQCP_SUCCESS) {
         goto EXIT;
     }
     memcpy(ctx->privateKey + ctx->para->pkeSkSize, ctx->publicKey, ctx->para->pkSize);
-    ret = SCLOUDPLUS_MdFunc(CRYPT_MD_SHA3_256, ctx->publicKey, ctx->para->pkSize, NULL, 0,
-                            ctx->privateKey + ctx->para->pkeSkSize + ctx->para->pkSize, &outLen);
+    ret = SCLOUDPLUS_MdFunc(CRYPT_MD_SHA3_256, ctx->publicKey, ctx->para->pkSize, NULL, 0, ctx->hpk, &outLen);
     if (ret != PQCP_SUCCESS) {
         goto EXIT;
     }
+    memcpy(ctx->privateKey + ctx->para->pkeSkSize + ctx->para->pkSize, ctx->hpk, SCLOUDPLUS_HPK_LEN);
     memcpy(ctx->privateKey + ctx->para->kemSkSize - SCLOUDPLUS_RAND_Z_LEN, z, SCLOUDPLUS_RAND_Z_LEN);
-
+    SCLOUDPLUS_ScratchCleanse(&ctx->scratch);
+    BSL_SAL_CleanseData(z, sizeof(z));
+    BSL_SAL_CleanseData(alpha, sizeof(alpha));
     return PQCP_SUCCESS;
 EXIT:
+    SCLOUDPLUS_ScratchCleanse(&ctx->scratch);
+    BSL_SAL_CleanseData(z, sizeof(z));
+    BSL_SAL_CleanseData(alpha, sizeof(alpha));
     if (ctx->publicKey != NULL) {
         BSL_SAL_FREE(ctx->publicKey);
     }
@@ -304,6 +608,8 @@ int32_t PQCP_SCLOUDPLUS_SetPrvKey(SCLOUDPLUS_Ctx *ctx, BSL_Param *param)
 
     uint32_t useLen = ctx->para->kemSkSize;
     memcpy(ctx->privateKey, prv->value, useLen);
+    SCLOUDPLUS_AlignedBufFree(&ctx->prepared.skB);
+    SCLOUDPLUS_AlignedBufFree(&ctx->prepared.S);
     return PQCP_SUCCESS;
 }
 
@@ -319,6 +625,13 @@ int32_t PQCP_SCLOUDPLUS_SetPubKey(SCLOUDPLUS_Ctx *ctx, BSL_Param *param)
     if (ctx->para->pkSize != pub->valueLen) {
         return PQCP_SCLOUDPLUS_INVALID_ARG;
     }
+    // 封装时直接使用缓存的H(pk)，避免每次对整个公钥做SHA3-256
+    uint8_t hpk[SCLOUDPLUS_HPK_LEN];
+    uint32_t hpkLen = SCLOUDPLUS_HPK_LEN;
+    int32_t ret = SCLOUDPLUS_MdFunc(CRYPT_MD_SHA3_256, pub->value, pub->valueLen, NULL, 0, hpk, &hpkLen);
+    if (ret != PQCP_SUCCESS) {
+        return ret;
+    }
     if (ctx->publicKey == NULL) {
         ctx->publicKey = BSL_SAL_Calloc(ctx->para->pkSize, sizeof(uint8_t));
         if (ctx->publicKey == NULL) {
@@ -328,6 +641,9 @@ int32_t PQCP_SCLOUDPLUS_SetPubKey(SCLOUDPLUS_Ctx *ctx, BSL_Param *param)
 
     uint32_t useLen = ctx->para->pkSize;
     memcpy(ctx->publicKey, pub->value, useLen);
+    memcpy(ctx->hpk, hpk, SCLOUDPLUS_HPK_LEN);
+    SCLOUDPLUS_AlignedBufFree(&ctx->prepared.pkB);
+    SCLOUDPLUS_EncapsPoolReset(&ctx->encapsPool, ctx->para);
     return PQCP_SUCCESS;
 }
 
@@ -384,6 +700,7 @@ SCLOUDPLUS_Ctx *PQCP_SCLOUDPLUS_DupCtx(SCLOUDPLUS_Ctx *src)
     }
     if (src->para != NULL) {
         ctx->para = src->para;
+        ctx->kernels = src->kernels;
     }
     if (src->publicKey != NULL) {
         ctx->publicKey = BSL_SAL_Calloc(src->para->pkSize, sizeof(uint8_t));
@@ -392,6 +709,7 @@ SCLOUDPLUS_Ctx *PQCP_SCLOUDPLUS_DupCtx(SCLOUDPLUS_Ctx *src)
             return NULL;
         }
         memcpy(ctx->publicKey, src->publicKey, ctx->para->pkSize);
+        memcpy(ctx->hpk, src->hpk, SCLOUDPLUS_HPK_LEN);
     }
     if (src->privateKey != NULL) {
         ctx->privateKey = BSL_SAL_Calloc(src->para->kemSkSize, sizeof(uint8_t));
@@ -401,6 +719,27 @@ SCLOUDPLUS_Ctx *PQCP_SCLOUDPLUS_DupCtx(SCLOUDPLUS_Ctx *src)
         }
         memcpy(ctx->privateKey, src->privateKey, ctx->para->kemSkSize);
     }
+    ctx->matrixA.budget = src->matrixA.budget;
+    ctx->parallel.cfg = src->parallel.cfg;
+    // 池中的密文只能使用一次，不复制
+    if (src->encapsPool.capacity != 0) {
+        ctx->encapsPool.ct = BSL_SAL_Calloc(src->encapsPool.capacity, src->para->ctxSize + src->para->ss);
+        if (ctx->encapsPool.ct == NULL) {
+            PQCP_SCLOUDPLUS_FreeCtx(ctx);
+            return NULL;
+        }
+        ctx->encapsPool.capacity = src->encapsPool.capacity;
+        ctx->encapsPool.ss = ctx->encapsPool.ct + src->encapsPool.capacity * src->para->ctxSize;
+    }
+    if (src->matrixA.rowNum != 0) {
+        ctx->matrixA.rows = BSL_SAL_Dump(src->matrixA.rows, src->matrixA.rowNum * src->para->n * sizeof(uint16_t));
+        if (ctx->matrixA.rows == NULL) {
+            PQCP_SCLOUDPLUS_FreeCtx(ctx);
+            return NULL;
+        }
+        ctx->matrixA.rowNum = src->matrixA.rowNum;
+        memcpy(ctx->matrixA.seedA, src->matrixA.seedA, SCLOUDPLUS_SEED_A_LEN);
+    }
     return ctx;
 }
 
@@ -419,18 +758,19 @@ int32_t PQCP_SCLOUDPLUS_Ctrl(SCLOUDPLUS_Ctx *ctx, int32_t cmd, void *val, uint32
                 return PQCP_SCLOUDPLUS_PARA_REPEATED_SET;
             }
             int32_t algId = *(int32_t *)val;
+            SCLOUDPLUS_PARA_SET set;
             if (algId == PQCP_SCLOUDPLUS_128) {
-                ctx->para = &PRESET_PARAS[0];
-                return PQCP_SUCCESS;
+                set = SCLOUDPLUS_PARA_SET1;
             } else if (algId == PQCP_SCLOUDPLUS_192) {
-                ctx->para = &PRESET_PARAS[1];
-                return PQCP_SUCCESS;
+                set = SCLOUDPLUS_PARA_SET2;
             } else if (algId == PQCP_SCLOUDPLUS_256) {
-                ctx->para = &PRESET_PARAS[2];
-                return PQCP_SUCCESS;
+                set = SCLOUDPLUS_PARA_SET3;
             } else {
                 return PQCP_SCLOUDPLUS_INVALID_ARG;
             }
+            ctx->para = SCLOUDPLUS_GetPara(set);
+            ctx->kernels = SCLOUDPLUS_GetKernels(set);
+            return PQCP_SUCCESS;
         }
         case CRYPT_CTRL_GET_PUBKEY_LEN: {
             if (ctx->para == NULL || val == NULL || valLen != sizeof(uint32_t)) {
@@ -474,6 +814,80 @@ int32_t PQCP_SCLOUDPLUS_Ctrl(SCLOUDPLUS_Ctx *ctx, int32_t cmd, void *val, uint32
             *(uint32_t *)val = ctx->para->ss * 8;
             return PQCP_SUCCESS;
         }
+        case PQCP_SCLOUDPLUS_SET_MATRIX_A_CACHE: {
+            if (val == NULL || valLen != sizeof(uint32_t)) {
+                return PQCP_NULL_INPUT;
+            }
+            SCLOUDPLUS_FreeMatrixA(&ctx->matrixA);
+            ctx->matrixA.budget = *(uint32_t *)val;
+            return PQCP_SUCCESS;
+        }
+        case PQCP_SCLOUDPLUS_SET_PARALLEL: {
+            if (val == NULL || valLen != sizeof(PQCP_ParallelCfg)) {
+                return PQCP_NULL_INPUT;
+            }
+            const PQCP_ParallelCfg *cfg = (const PQCP_ParallelCfg *)val;
+            if (cfg->parallelFor != NULL && (cfg->taskNum == 0 || cfg->taskNum > SCLOUDPLUS_PARALLEL_MAX)) {
+                return PQCP_SCLOUDPLUS_INVALID_ARG;
+            }
+            SCLOUDPLUS_AlignedBufFree(&ctx->parallel.mem);
+            ctx->parallel.cfg = *cfg;
+            return PQCP_SUCCESS;
+        }
+        case PQCP_SCLOUDPLUS_SET_KEYGEN_SEED: {
+            // val为z || alpha
+            if (val == NULL || valLen != SCLOUDPLUS_RAND_Z_LEN + SCLOUDPLUS_ALPHA_LEN) {
+                return PQCP_NULL_INPUT;
+            }
+            memcpy(ctx->seed.z, val, SCLOUDPLUS_RAND_Z_LEN);
+            memcpy(ctx->seed.alpha, (const uint8_t *)val + SCLOUDPLUS_RAND_Z_LEN, SCLOUDPLUS_ALPHA_LEN);
+            ctx->seed.keygenSet = 1;
+            return PQCP_SUCCESS;
+        }
+        case PQCP_SCLOUDPLUS_SET_ENCAPS_POOL: {
+            if (ctx->para == NULL || val == NULL || valLen != sizeof(uint32_t)) {
+                return PQCP_NULL_INPUT;
+            }
+            uint32_t capacity = *(uint32_t *)val;
+            if (capacity > SCLOUDPLUS_ENCAPS_POOL_MAX) {
+                return PQCP_SCLOUDPLUS_INVALID_ARG;
+            }
+            SCLOUDPLUS_EncapsPoolFree(&ctx->encapsPool, ctx->para);
+            ctx->encapsPool.capacity = 0;
+            if (capacity == 0) {
+                return PQCP_SUCCESS;
+            }
+            ctx->encapsPool.ct = BSL_SAL_Calloc(capacity, ctx->para->ctxSize + ctx->para->ss);
+            if (ctx->encapsPool.ct == NULL) {
+                return PQCP_MEM_ALLOC_FAIL;
+            }
+            ctx->encapsPool.capacity = capacity;
+            ctx->encapsPool.ss = ctx->encapsPool.ct + capacity * ctx->para->ctxSize;
+            return PQCP_SUCCESS;
+        }
+        case PQCP_SCLOUDPLUS_GET_ENCAPS_POOL_NUM: {
+            if (val == NULL || valLen != sizeof(uint32_t)) {
+                return PQCP_NULL_INPUT;
+            }
+            *(uint32_t *)val = ctx->encapsPool.num;
+            return PQCP_SUCCESS;
+        }
+        case PQCP_SCLOUDPLUS_FILL_ENCAPS_POOL: {
+            // val为本次最多新增的组数
+            if (val == NULL || valLen != sizeof(uint32_t)) {
+                return PQCP_NULL_INPUT;
+            }
+            return PQCP_SCLOUDPLUS_FillEncapsPool(ctx, *(uint32_t *)val);
+        }
+        case PQCP_SCLOUDPLUS_SET_ENCAPS_SEED: {
+            // val为m，长度为共享密钥长度，仅作用于下一次PQCP_SCLOUDPLUS_Encaps
+            if (ctx->para == NULL || val == NULL || valLen != ctx->para->ss) {
+                return PQCP_NULL_INPUT;
+            }
+            memcpy(ctx->seed.m, val, valLen);
+            ctx->seed.encapsSet = 1;
+            return PQCP_SUCCESS;
+        }
         default:
             return PQCP_SCLOUDPLUS_INVALID_ARG;
     }
@@ -493,6 +907,14 @@ void PQCP_SCLOUDPLUS_FreeCtx(SCLOUDPLUS_Ctx *ctx)
         }
         BSL_SAL_FREE(ctx->privateKey);
     }
+    SCLOUDPLUS_FreeMatrixA(&ctx->matrixA);
+    SCLOUDPLUS_FreePreparedKey(&ctx->prepared);
+    SCLOUDPLUS_ScratchFree(&ctx->scratch);
+    SCLOUDPLUS_AlignedBufFree(&ctx->parallel.mem);
+    if (ctx->para != NULL) {
+        SCLOUDPLUS_EncapsPoolFree(&ctx->encapsPool, ctx->para);
+    }
+    BSL_SAL_CleanseData(&ctx->seed, sizeof(ctx->seed));
     BSL_SAL_FREE(ctx);
 }
 
@@ -520,36 +942,56 @@ int32_t PQCP_SCLOUDPLUS_Encaps(SCLOUDPLUS_Ctx *ctx, uint8_t *ciphertext, uint32_
     if (*ctLen < ctx->para->ctxSize || *ssLen < ctx->para->ss) {
         return PQCP_INVALID_ARG;
     }
-    uint8_t in[ctx->para->ss + SCLOUDPLUS_HPK_LEN + SCLOUDPLUS_RAND_R_LEN + SCLOUDPLUS_SEED_K_LEN];
-    uint8_t *C = ciphertext;
-    uint8_t *m = in;
-    uint8_t *hpk = in + ctx->para->ss;
-    uint8_t *r = in + ctx->para->ss + SCLOUDPLUS_HPK_LEN;
-    uint8_t *k = in + ctx->para->ss + SCLOUDPLUS_HPK_LEN + SCLOUDPLUS_RAND_R_LEN;
-    uint32_t outLen = SCLOUDPLUS_HPK_LEN;
-    int32_t ret = CRYPT_EAL_Randbytes(m, ctx->para->ss);
+    // 预计算池中的共享密钥长度为ss，设置了确定性种子时不使用池
+    if (ctx->encapsPool.num != 0 && ctx->seed.encapsSet == 0 && *ssLen == ctx->para->ss) {
+        SCLOUDPLUS_EncapsPool *pool = &ctx->encapsPool;
+        pool->num--;
+        memcpy(ciphertext, pool->ct + pool->num * ctx->para->ctxSize, ctx->para->ctxSize);
+        memcpy(sharedSecret, pool->ss + pool->num * ctx->para->ss, ctx->para->ss);
+        BSL_SAL_CleanseData(pool->ss + pool->num * ctx->para->ss, ctx->para->ss);
+        *ctLen = ctx->para->ctxSize;
+        return PQCP_SUCCESS;
+    }
+    int32_t ret = SCLOUDPLUS_ScratchInit(ctx);
     if (ret != PQCP_SUCCESS) {
         return ret;
     }
-    ret = SCLOUDPLUS_MdFunc(CRYPT_MD_SHA3_256, ctx->publicKey, ctx->para->pkSize, NULL, 0, hpk, &outLen);
+    uint8_t in[ctx->para->ss + SCLOUDPLUS_RAND_R_LEN + SCLOUDPLUS_SEED_K_LEN];
+    uint8_t *C = ciphertext;
+    uint8_t *m = in;
+    uint8_t *r = in + ctx->para->ss;
+    uint8_t *k = in + ctx->para->ss + SCLOUDPLUS_RAND_R_LEN;
+    const uint8_t seedSet = ctx->seed.encapsSet;
+    ctx->seed.encapsSet = 0;
+    ret = SCLOUDPLUS_Randbytes(ctx->seed.m, seedSet, m, ctx->para->ss);
     if (ret != PQCP_SUCCESS) {
-        return ret;
+        goto EXIT;
+    }
+    const uint16_t *B = SCLOUDPLUS_PrepareB(ctx, ctx->publicKey, &ctx->prepared.pkB);
+    if (B == NULL) {
+        ret = PQCP_MEM_ALLOC_FAIL;
+        goto EXIT;
     }
-    outLen = SCLOUDPLUS_RAND_R_LEN + SCLOUDPLUS_SEED_K_LEN;
-    ret = SCLOUDPLUS_MdFunc(CRYPT_MD_SHA3_512, m, ctx->para->ss, hpk, SCLOUDPLUS_HPK_LEN, r, &outLen);
+    uint32_t outLen = SCLOUDPLUS_RAND_R_LEN + SCLOUDPLUS_SEED_K_LEN;
+    ret = SCLOUDPLUS_MdCtxFunc(ctx->scratch.sha3512, m, ctx->para->ss, ctx->hpk, SCLOUDPLUS_HPK_LEN, r, &outLen);
     if (ret != PQCP_SUCCESS) {
-        return ret;
+        goto EXIT;
     }
-    ret = SCLOUDPLUS_PKEEncrypt(ctx->publicKey, m, r, ctx->para, C);
+    SCLOUDPLUS_CtSink ct = {C, NULL, 0};
+    ret = SCLOUDPLUS_PKEEncrypt(ctx, ctx->publicKey, B, m, r, &ct);
     if (ret != PQCP_SUCCESS) {
-        return ret;
+        goto EXIT;
     }
-    ret = SCLOUDPLUS_MdFunc(CRYPT_MD_SHAKE256, k, SCLOUDPLUS_SEED_K_LEN, C, ctx->para->ctxSize, sharedSecret, ssLen);
+    ret = SCLOUDPLUS_MdCtxFunc(ctx->scratch.shake256, k, SCLOUDPLUS_SEED_K_LEN, C, ctx->para->ctxSize, sharedSecret,
+        ssLen);
     if (ret != PQCP_SUCCESS) {
-        return ret;
+        goto EXIT;
     }
     *ctLen = ctx->para->ctxSize;
-    return PQCP_SUCCESS;
+EXIT:
+    SCLOUDPLUS_ScratchCleanse(&ctx->scratch);
+    BSL_SAL_CleanseData(in, sizeof(in));
+    return ret;
 }
 
 int32_t PQCP_SCLOUDPLUS_Decaps(SCLOUDPLUS_Ctx *ctx, const uint8_t *ciphertext, uint32_t ctLen, uint8_t *sharedSecret,
@@ -562,8 +1004,19 @@ int32_t PQCP_SCLOUDPLUS_Decaps(SCLOUDPLUS_Ctx *ctx, const uint8_t *ciphertext, u
     if (ctLen != ctx->para->ctxSize || *ssLen < ctx->para->ss) {
         return PQCP_INVALID_ARG;
     }
-    uint8_t *C1 = BSL_SAL_Malloc(ctx->para->ctxSize);
-    if (C1 == NULL) {
+    int32_t ret = SCLOUDPLUS_ScratchInit(ctx);
+    if (ret != PQCP_SUCCESS) {
+        return ret;
+    }
+    const uint8_t *pk = ctx->privateKey + ctx->para->pkeSkSize;
+    ret = SCLOUDPLUS_PrepareS(ctx, ctx->privateKey, &ctx->prepared.S);
+    if (ret != PQCP_SUCCESS) {
+        SCLOUDPLUS_ScratchCleanse(&ctx->scratch);
+        return ret;
+    }
+    const uint16_t *B = SCLOUDPLUS_PrepareB(ctx, pk, &ctx->prepared.skB);
+    if (B == NULL) {
+        SCLOUDPLUS_ScratchCleanse(&ctx->scratch);
         return PQCP_MEM_ALLOC_FAIL;
     }
     uint8_t in[ctx->para->ss + SCLOUDPLUS_RAND_R_LEN + SCLOUDPLUS_SEED_K_LEN];
@@ -574,28 +1027,154 @@ int32_t PQCP_SCLOUDPLUS_Decaps(SCLOUDPLUS_Ctx *ctx, const uint8_t *ciphertext, u
     uint8_t *k1 = in + ctx->para->ss + SCLOUDPLUS_RAND_R_LEN;
 
     uint32_t outLen = SCLOUDPLUS_RAND_R_LEN + SCLOUDPLUS_SEED_K_LEN;
-    int32_t ret = SCLOUDPLUS_PKEDecrypt(ctx->privateKey, C, ctx->para, m1);
+    ret = SCLOUDPLUS_PKEDecrypt(ctx, ctx->prepared.S.data, C, m1);
     if (ret != PQCP_SUCCESS) {
         goto EXIT;
     }
-    ret = SCLOUDPLUS_MdFunc(CRYPT_MD_SHA3_512, m1, ctx->para->ss, hpk, SCLOUDPLUS_HPK_LEN, r1, &outLen);
+    ret = SCLOUDPLUS_MdCtxFunc(ctx->scratch.sha3512, m1, ctx->para->ss, hpk, SCLOUDPLUS_HPK_LEN, r1, &outLen);
     if (ret != PQCP_SUCCESS) {
         goto EXIT;
     }
-    ret = SCLOUDPLUS_PKEEncrypt(ctx->privateKey + ctx->para->pkeSkSize, m1, r1, ctx->para, C1);
+    SCLOUDPLUS_CtSink reCt = {NULL, C, 0};
+    ret = SCLOUDPLUS_PKEEncrypt(ctx, pk, B, m1, r1, &reCt);
     if (ret != PQCP_SUCCESS) {
         goto EXIT;
     }
-    int8_t bl = SCLOUDPLUS_Verify(C, C1, ctx->para->ctxSize);
     *ssLen = ctx->para->ss;
-    if (bl == 0) {
-        ret = SCLOUDPLUS_MdFunc(CRYPT_MD_SHAKE256, k1, SCLOUDPLUS_SEED_K_LEN, C, ctx->para->ctxSize, sharedSecret, ssLen);
+    if (reCt.diff == 0) {
+        ret = SCLOUDPLUS_MdCtxFunc(ctx->scratch.shake256, k1, SCLOUDPLUS_SEED_K_LEN, C, ctx->para->ctxSize,
+            sharedSecret, ssLen);
     } else {
-        ret = SCLOUDPLUS_MdFunc(CRYPT_MD_SHAKE256, ctx->privateKey + ctx->para->kemSkSize - SCLOUDPLUS_RAND_Z_LEN, SCLOUDPLUS_RAND_Z_LEN, C,
-                                ctx->para->ctxSize, sharedSecret, ssLen);
+        ret = SCLOUDPLUS_MdCtxFunc(ctx->scratch.shake256, ctx->privateKey + ctx->para->kemSkSize - SCLOUDPLUS_RAND_Z_LEN,
+            SCLOUDPLUS_RAND_Z_LEN, C, ctx->para->ctxSize, sharedSecret, ssLen);
+    }
+EXIT:
+    SCLOUDPLUS_ScratchCleanse(&ctx->scratch);
+    BSL_SAL_CleanseData(in, sizeof(in));
+    return ret;
+}
+
+// 同一批内的密文共用一次矩阵A的遍历：先逐个采样并输出C2，再统一计算C1，最后逐个导出共享密钥
+static int32_t SCLOUDPLUS_EncapsChunk(SCLOUDPLUS_Ctx *ctx, const uint16_t *B, const uint32_t num, uint8_t *ciphertext,
+    uint8_t *sharedSecret)
+{
+    const SCLOUDPLUS_Para *para = ctx->para;
+    const uint32_t matLen = para->mbar * para->n;
+    const uint32_t sLen = para->mbar * para->m;
+    uint16_t *E1 = ctx->scratch.batch.data;
+    uint16_t *S1 = E1 + SCLOUDPLUS_ENCAPS_BATCH_MAX * matLen;
+    const uint8_t *seedA = ctx->publicKey + para->pkSize - SCLOUDPLUS_SEED_A_LEN;
+    uint8_t in[para->ss + SCLOUDPLUS_RAND_R_LEN + SCLOUDPLUS_SEED_K_LEN];
+    uint8_t k[SCLOUDPLUS_ENCAPS_BATCH_MAX][SCLOUDPLUS_SEED_K_LEN];
+    uint8_t *m = in;
+    uint8_t *r = in + para->ss;
+    int32_t ret = PQCP_SUCCESS;
+    for (uint32_t b = 0; b < num; b++) {
+        ret = CRYPT_EAL_Randbytes(m, para->ss);
+        if (ret != PQCP_SUCCESS) {
+            goto EXIT;
+        }
+        uint32_t outLen = SCLOUDPLUS_RAND_R_LEN + SCLOUDPLUS_SEED_K_LEN;
+        ret = SCLOUDPLUS_MdCtxFunc(ctx->scratch.sha3512, m, para->ss, ctx->hpk, SCLOUDPLUS_HPK_LEN, r, &outLen);
+        if (ret != PQCP_SUCCESS) {
+            goto EXIT;
+        }
+        memcpy(k[b], r + SCLOUDPLUS_RAND_R_LEN, SCLOUDPLUS_SEED_K_LEN);
+        SCLOUDPLUS_CtSink ct = {ciphertext + b * para->ctxSize, NULL, 0};
+        ret = SCLOUDPLUS_PKEEncryptPrepare(ctx, B, m, r, S1 + b * sLen, E1 + b * matLen, &ct);
+        if (ret != PQCP_SUCCESS) {
+            goto EXIT;
+        }
+    }
+    ret = ctx->kernels->saERows(seedA, ctx->matrixA.rows, ctx->matrixA.rowNum, num, S1, E1, para, 0, para->m,
+        ctx->scratch.tmp);
+    if (ret != PQCP_SUCCESS) {
+        goto EXIT;
+    }
+    for (uint32_t b = 0; b < num; b++) {
+        SCLOUDPLUS_CtSink ct = {ciphertext + b * para->ctxSize, NULL, 0};
+        uint32_t ssLen = para->ss;
+        SCLOUDPLUS_PKEEncryptFinish(ctx, E1 + b * matLen, &ct);
+        ret = SCLOUDPLUS_MdCtxFunc(ctx->scratch.shake256, k[b], SCLOUDPLUS_SEED_K_LEN, ct.out, para->ctxSize,
+            sharedSecret + b * para->ss, &ssLen);
+        if (ret != PQCP_SUCCESS) {
+            goto EXIT;
+        }
+    }
+EXIT:
+    BSL_SAL_CleanseData(in, sizeof(in));
+    BSL_SAL_CleanseData(k, sizeof(k));
+    return ret;
+}
+
+int32_t PQCP_SCLOUDPLUS_EncapsBatch(SCLOUDPLUS_Ctx *ctx, uint32_t num, uint8_t *ciphertext, uint32_t *ctLen,
+    uint8_t *sharedSecret, uint32_t *ssLen)
+{
+    if (ctx == NULL || ctx->para == NULL || ctx->publicKey == NULL || ciphertext == NULL || sharedSecret == NULL
+        || ctLen == NULL || ssLen == NULL) {
+        return PQCP_NULL_INPUT;
+    }
+    const SCLOUDPLUS_Para *para = ctx->para;
+    if (num == 0 || (uint64_t)num * para->ctxSize > *ctLen || (uint64_t)num * para->ss > *ssLen) {
+        return PQCP_INVALID_ARG;
+    }
+    int32_t ret = SCLOUDPLUS_ScratchInit(ctx);
+    if (ret != PQCP_SUCCESS) {
+        return ret;
+    }
+    ret = SCLOUDPLUS_BatchInit(ctx);
+    if (ret != PQCP_SUCCESS) {
+        return ret;
+    }
+    const uint16_t *B = SCLOUDPLUS_PrepareB(ctx, ctx->publicKey, &ctx->prepared.pkB);
+    if (B == NULL) {
+        return PQCP_MEM_ALLOC_FAIL;
+    }
+    ret = SCLOUDPLUS_LoadMatrixA(ctx, ctx->publicKey + para->pkSize - SCLOUDPLUS_SEED_A_LEN);
+    if (ret != PQCP_SUCCESS) {
+        goto EXIT;
+    }
+    for (uint32_t done = 0; done < num; done += SCLOUDPLUS_ENCAPS_BATCH_MAX) {
+        const uint32_t cnt = (num - done < SCLOUDPLUS_ENCAPS_BATCH_MAX) ? (num - done) : SCLOUDPLUS_ENCAPS_BATCH_MAX;
+        ret = SCLOUDPLUS_EncapsChunk(ctx, B, cnt, ciphertext + done * para->ctxSize, sharedSecret + done * para->ss);
+        if (ret != PQCP_SUCCESS) {
+            goto EXIT;
+        }
     }
+    *ctLen = num * para->ctxSize;
+    *ssLen = num * para->ss;
 EXIT:
-    BSL_SAL_FREE(C1);
+    SCLOUDPLUS_ScratchCleanse(&ctx->scratch);
+    BSL_SAL_CleanseData(ctx->scratch.batch.mem, ctx->scratch.batch.size);
     return ret;
 }
+
+int32_t PQCP_SCLOUDPLUS_FillEncapsPool(SCLOUDPLUS_Ctx *ctx, uint32_t maxNum)
+{
+    if (ctx == NULL || ctx->para == NULL || ctx->publicKey == NULL) {
+        return PQCP_NULL_INPUT;
+    }
+    SCLOUDPLUS_EncapsPool *pool = &ctx->encapsPool;
+    const SCLOUDPLUS_Para *para = ctx->para;
+    if (pool->capacity == 0) {
+        return PQCP_INVALID_ARG;
+    }
+    uint32_t num = pool->capacity - pool->num;
+    if (num > maxNum) {
+        num = maxNum;
+    }
+    if (num == 0) {
+        return PQCP_SUCCESS;
+    }
+    uint8_t *ss = pool->ss + pool->num * para->ss;
+    uint32_t ctLen = num * para->ctxSize;
+    uint32_t ssLen = num * para->ss;
+    int32_t ret = PQCP_SCLOUDPLUS_EncapsBatch(ctx, num, pool->ct + pool->num * para->ctxSize, &ctLen, ss, &ssLen);
+    if (ret != PQCP_SUCCESS) {
+        BSL_SAL_CleanseData(ss, num * para->ss);
+        return ret;
+    }
+    pool->num += num;
+    return PQCP_SUCCESS;
+}
 #endif // PQCP_SCLOUDPLUS
@@ -0,0 +1,254 @@
+/*
+ * This file is part of the openHiTLS project.
+ *
+ * openHiTLS is licensed under the Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *     http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ */
+#ifdef PQCP_SCLOUDPLUS
+#include "scloudplus_local.h"
+
+#ifdef SCLOUDPLUS_AES_NATIVE
+/*
+ * 矩阵A的AES-128-ECB展开：第row行第p个16字节分组 = AES(seedA, ctr)，ctr首个32位字为row * (n / 8) + p，其余为0；
+ * 每个分组即A[row][8p, 8p + 8)。此处直接调用AES轮指令，8个分组并行，计数器在寄存器中构造。
+ */
+#define AES_ROUNDS 10
+// 8路展开，保证8个分组状态常驻寄存器
+#define REP8(M) M(0) M(1) M(2) M(3) M(4) M(5) M(6) M(7)
+
+#if defined(__AES__) && defined(__x86_64__)
+#include <immintrin.h>
+#include <wmmintrin.h>
+
+typedef __m128i DATA128b;
+#define SIMD_LOAD(x)     _mm_loadu_si128((const __m128i *)(x))
+#define SIMD_STORE(x, y) _mm_storeu_si128((__m128i *)(x), (y))
+#define SIMD_XOR(x, y)   _mm_xor_si128((x), (y))
+#define SIMD_CTR(x)      _mm_cvtsi32_si128((int32_t)(x))
+
+#define AES_KEY_EXP(rk, i, rcon)                                                          \
+    do {                                                                                  \
+        __m128i gen = _mm_shuffle_epi32(_mm_aeskeygenassist_si128((rk)[(i) - 1], (rcon)), 0xff); \
+        __m128i key = (rk)[(i) - 1];                                                      \
+        key = _mm_xor_si128(key, _mm_slli_si128(key, 4));                                 \
+        key = _mm_xor_si128(key, _mm_slli_si128(key, 4));                                 \
+        key = _mm_xor_si128(key, _mm_slli_si128(key, 4));                                 \
+        (rk)[i] = _mm_xor_si128(key, gen);                                                \
+    } while (0)
+
+void SCLOUDPLUS_AesKeyInit(const uint8_t *seedA, SCLOUDPLUS_AesKey *key)
+{
+    __m128i rk[AES_ROUNDS + 1];
+    rk[0] = SIMD_LOAD(seedA);
+    AES_KEY_EXP(rk, 1, 0x01);
+    AES_KEY_EXP(rk, 2, 0x02);
+    AES_KEY_EXP(rk, 3, 0x04);
+    AES_KEY_EXP(rk, 4, 0x08);
+    AES_KEY_EXP(rk, 5, 0x10);
+    AES_KEY_EXP(rk, 6, 0x20);
+    AES_KEY_EXP(rk, 7, 0x40);
+    AES_KEY_EXP(rk, 8, 0x80);
+    AES_KEY_EXP(rk, 9, 0x1b);
+    AES_KEY_EXP(rk, 10, 0x36);
+    for (int i = 0; i <= AES_ROUNDS; i++) {
+        SIMD_STORE(key->rk[i], rk[i]);
+    }
+}
+
+__attribute__((always_inline)) static inline void AesEncrypt8(const DATA128b *rk, DATA128b s[8])
+{
+    DATA128b k = rk[0];
+#define AES_XOR8(b)  s[b] = SIMD_XOR(s[b], k);
+#define AES_ENC8(b)  s[b] = _mm_aesenc_si128(s[b], k);
+#define AES_LAST8(b) s[b] = _mm_aesenclast_si128(s[b], k);
+    REP8(AES_XOR8)
+    for (int r = 1; r < AES_ROUNDS; r++) {
+        k = rk[r];
+        REP8(AES_ENC8)
+    }
+    k = rk[AES_ROUNDS];
+    REP8(AES_LAST8)
+#undef AES_XOR8
+#undef AES_ENC8
+#undef AES_LAST8
+}
+
+// 8x8 uint16转置：输入s[r]为第r行的8个元素，输出s[c]为第c列的8个元素
+__attribute__((always_inline)) static inline void Transpose8x8(DATA128b s[8])
+{
+    DATA128b a0 = _mm_unpacklo_epi16(s[0], s[1]);
+    DATA128b a1 = _mm_unpackhi_epi16(s[0], s[1]);
+    DATA128b a2 = _mm_unpacklo_epi16(s[2], s[3]);
+    DATA128b a3 = _mm_unpackhi_epi16(s[2], s[3]);
+    DATA128b a4 = _mm_unpacklo_epi16(s[4], s[5]);
+    DATA128b a5 = _mm_unpackhi_epi16(s[4], s[5]);
+    DATA128b a6 = _mm_unpacklo_epi16(s[6], s[7]);
+    DATA128b a7 = _mm_unpackhi_epi16(s[6], s[7]);
+    DATA128b b0 = _mm_unpacklo_epi32(a0, a2);
+    DATA128b b1 = _mm_unpackhi_epi32(a0, a2);
+    DATA128b b2 = _mm_unpacklo_epi32(a1, a3);
+    DATA128b b3 = _mm_unpackhi_epi32(a1, a3);
+    DATA128b b4 = _mm_unpacklo_epi32(a4, a6);
+    DATA128b b5 = _mm_unpackhi_epi32(a4, a6);
+    DATA128b b6 = _mm_unpacklo_epi32(a5, a7);
+    DATA128b b7 = _mm_unpackhi_epi32(a5, a7);
+    s[0] = _mm_unpacklo_epi64(b0, b4);
+    s[1] = _mm_unpackhi_epi64(b0, b4);
+    s[2] = _mm_unpacklo_epi64(b1, b5);
+    s[3] = _mm_unpackhi_epi64(b1, b5);
+    s[4] = _mm_unpacklo_epi64(b2, b6);
+    s[5] = _mm_unpackhi_epi64(b2, b6);
+    s[6] = _mm_unpacklo_epi64(b3, b7);
+    s[7] = _mm_unpackhi_epi64(b3, b7);
+}
+
+#elif defined(__ARM_FEATURE_CRYPTO) && defined(__ARM_NEON)
+#include <arm_neon.h>
+
+typedef uint8x16_t DATA128b;
+#define SIMD_LOAD(x)     vld1q_u8((const uint8_t *)(x))
+#define SIMD_STORE(x, y) vst1q_u8((uint8_t *)(x), (y))
+#define SIMD_XOR(x, y)   veorq_u8((x), (y))
+#define SIMD_CTR(x)      vreinterpretq_u8_u32(vsetq_lane_u32((uint32_t)(x), vdupq_n_u32(0), 0))
+
+// SubWord：4列相同时ShiftRows不改变结果，AESE(x, 0)即逐字节S盒替换
+static inline uint32_t AesSubWord(uint32_t w)
+{
+    uint8x16_t t = vaeseq_u8(vreinterpretq_u8_u32(vdupq_n_u32(w)), vdupq_n_u8(0));
+    return vgetq_lane_u32(vreinterpretq_u32_u8(t), 0);
+}
+
+void SCLOUDPLUS_AesKeyInit(const uint8_t *seedA, SCLOUDPLUS_AesKey *key)
+{
+    static const uint8_t rcon[AES_ROUNDS] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36};
+    uint32_t w[4 * (AES_ROUNDS + 1)];
+    for (int i = 0; i < 4; i++) {
+        w[i] = (uint32_t)seedA[4 * i] | ((uint32_t)seedA[4 * i + 1] << 8) | ((uint32_t)seedA[4 * i + 2] << 16) |
+            ((uint32_t)seedA[4 * i + 3] << 24);
+    }
+    for (int i = 4; i < 4 * (AES_ROUNDS + 1); i++) {
+        uint32_t t = w[i - 1];
+        if (i % 4 == 0) {
+            t = AesSubWord((t >> 8) | (t << 24)) ^ rcon[i / 4 - 1];
+        }
+        w[i] = w[i - 4] ^ t;
+    }
+    for (int i = 0; i <= AES_ROUNDS; i++) {
+        for (int j = 0; j < 4; j++) {
+            key->rk[i][4 * j] = (uint8_t)w[4 * i + j];
+            key->rk[i][4 * j + 1] = (uint8_t)(w[4 * i + j] >> 8);
+            key->rk[i][4 * j + 2] = (uint8_t)(w[4 * i + j] >> 16);
+            key->rk[i][4 * j + 3] = (uint8_t)(w[4 * i + j] >> 24);
+        }
+    }
+}
+
+__attribute__((always_inline)) static inline void AesEncrypt8(const DATA128b *rk, DATA128b s[8])
+{
+    DATA128b k;
+    const DATA128b last = rk[AES_ROUNDS];
+#define AES_ENC8(b)  s[b] = vaesmcq_u8(vaeseq_u8(s[b], k));
+#define AES_LAST8(b) s[b] = SIMD_XOR(vaeseq_u8(s[b], k), last);
+    for (int r = 0; r < AES_ROUNDS - 1; r++) {
+        k = rk[r];
+        REP8(AES_ENC8)
+    }
+    k = rk[AES_ROUNDS - 1];
+    REP8(AES_LAST8)
+#undef AES_ENC8
+#undef AES_LAST8
+}
+
+// 8x8 uint16转置：输入s[r]为第r行的8个元素，输出s[c]为第c列的8个元素
+__attribute__((always_inline)) static inline void Transpose8x8(DATA128b s[8])
+{
+    uint16x8x2_t t0 = vtrnq_u16(vreinterpretq_u16_u8(s[0]), vreinterpretq_u16_u8(s[1]));
+    uint16x8x2_t t1 = vtrnq_u16(vreinterpretq_u16_u8(s[2]), vreinterpretq_u16_u8(s[3]));
+    uint16x8x2_t t2 = vtrnq_u16(vreinterpretq_u16_u8(s[4]), vreinterpretq_u16_u8(s[5]));
+    uint16x8x2_t t3 = vtrnq_u16(vreinterpretq_u16_u8(s[6]), vreinterpretq_u16_u8(s[7]));
+    // u0/u1：前4行，u2/u3：后4行；val[j]的低64位为一列、高64位为其后第4列
+    uint32x4x2_t u0 = vtrnq_u32(vreinterpretq_u32_u16(t0.val[0]), vreinterpretq_u32_u16(t1.val[0]));
+    uint32x4x2_t u1 = vtrnq_u32(vreinterpretq_u32_u16(t0.val[1]), vreinterpretq_u32_u16(t1.val[1]));
+    uint32x4x2_t u2 = vtrnq_u32(vreinterpretq_u32_u16(t2.val[0]), vreinterpretq_u32_u16(t3.val[0]));
+    uint32x4x2_t u3 = vtrnq_u32(vreinterpretq_u32_u16(t2.val[1]), vreinterpretq_u32_u16(t3.val[1]));
+#define TRN_COMBINE(lo, hi, part) \
+    vreinterpretq_u8_u16(vcombine_u16(part(vreinterpretq_u16_u32(lo)), part(vreinterpretq_u16_u32(hi))))
+    s[0] = TRN_COMBINE(u0.val[0], u2.val[0], vget_low_u16);
+    s[4] = TRN_COMBINE(u0.val[0], u2.val[0], vget_high_u16);
+    s[1] = TRN_COMBINE(u1.val[0], u3.val[0], vget_low_u16);
+    s[5] = TRN_COMBINE(u1.val[0], u3.val[0], vget_high_u16);
+    s[2] = TRN_COMBINE(u0.val[1], u2.val[1], vget_low_u16);
+    s[6] = TRN_COMBINE(u0.val[1], u2.val[1], vget_high_u16);
+    s[3] = TRN_COMBINE(u1.val[1], u3.val[1], vget_low_u16);
+    s[7] = TRN_COMBINE(u1.val[1], u3.val[1], vget_high_u16);
+#undef TRN_COMBINE
+}
+#endif
+
+static inline void AesLoadKey(const SCLOUDPLUS_AesKey *key, DATA128b rk[AES_ROUNDS + 1])
+{
+    for (int i = 0; i <= AES_ROUNDS; i++) {
+        rk[i] = SIMD_LOAD(key->rk[i]);
+    }
+}
+
+void SCLOUDPLUS_AesGenRows(const SCLOUDPLUS_AesKey *key, const SCLOUDPLUS_Para *para, const uint32_t row,
+                           const uint32_t rowNum, uint16_t *out)
+{
+    DATA128b rk[AES_ROUNDS + 1];
+    DATA128b s[8];
+    AesLoadKey(key, rk);
+    const uint32_t blockNumber = para->n >> 3;
+    const uint32_t total = rowNum * blockNumber;
+    const uint32_t ctr = row * blockNumber;
+    uint32_t b = 0;
+    // 各行连续，计数器随输出分组线性递增
+#define CTR_LINEAR(k)  s[k] = SIMD_CTR(ctr + b + (k));
+#define STORE_LINEAR(k) SIMD_STORE(out + (b + (k)) * 8, s[k]);
+#define STORE_TAIL(k)   if (b + (k) < total) { SIMD_STORE(out + (b + (k)) * 8, s[k]); }
+    for (; b + 8 <= total; b += 8) {
+        REP8(CTR_LINEAR)
+        AesEncrypt8(rk, s);
+        REP8(STORE_LINEAR)
+    }
+    if (b < total) {
+        REP8(CTR_LINEAR)
+        AesEncrypt8(rk, s);
+        REP8(STORE_TAIL)
+    }
+#undef CTR_LINEAR
+#undef STORE_LINEAR
+#undef STORE_TAIL
+}
+
+// 同一列分组的8行计数器，行间相差blockNumber
+#define CTR_COLUMN(r) s[r] = SIMD_CTR(ctr + (r) * blockNumber);
+
+void SCLOUDPLUS_AesGenRowsT(const SCLOUDPLUS_AesKey *key, const SCLOUDPLUS_Para *para, const uint32_t row,
+                            uint16_t *outT)
+{
+    DATA128b rk[AES_ROUNDS + 1];
+    DATA128b s[8];
+    AesLoadKey(key, rk);
+    const uint32_t blockNumber = para->n >> 3;
+#define STORE_COLUMN(c) SIMD_STORE(outT + (8 * p + (c)) * 8, s[c]);
+    for (uint32_t p = 0; p < blockNumber; p++) {
+        const uint32_t ctr = row * blockNumber + p;
+        REP8(CTR_COLUMN)
+        AesEncrypt8(rk, s);
+        Transpose8x8(s);
+        REP8(STORE_COLUMN)
+    }
+#undef STORE_COLUMN
+}
+#undef CTR_COLUMN
+#endif // SCLOUDPLUS_AES_NATIVE
+#endif // PQCP_SCLOUDPLUS
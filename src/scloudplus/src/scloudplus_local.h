@@ -36,6 +36,19 @@ extern "C" {
 #define SCLOUDPLUS_SECBITS3 256
 #define SCLOUDPLUS_BW_COMPLEX_LEN 16
 #define SCLOUDPLUS_MOD_Q 0xFFF
+#define SCLOUDPLUS_SA_E_ROWS 8
+#define SCLOUDPLUS_SA_E_TILE_ROWS 64 // SA_E每次展开的矩阵A行数，为SCLOUDPLUS_SA_E_ROWS的倍数
+#define SCLOUDPLUS_SA_E_TILE_COLS 64 // SA_E列条宽度，为向量宽度的倍数；E的一个列条驻留寄存器
+#define SCLOUDPLUS_MAX_N 1120
+#define SCLOUDPLUS_MAX_MBAR 12
+#define SCLOUDPLUS_ENCAPS_BATCH_MAX 8 // SA_E一次遍历矩阵A可服务的密文数
+#define SCLOUDPLUS_PARALLEL_MAX 64     // 并行模式的最大任务数
+#define SCLOUDPLUS_ENCAPS_POOL_MAX 256 // 预计算密文池的最大容量
+#define SCLOUDPLUS_ALIGN 64
+
+#if (defined(__AES__) && defined(__x86_64__)) || (defined(__ARM_FEATURE_CRYPTO) && defined(__ARM_NEON))
+#define SCLOUDPLUS_AES_NATIVE
+#endif
 typedef struct {
     int32_t real;
     int32_t imag;
@@ -74,36 +87,96 @@ struct SCLOUDPLUSPara {
     uint16_t kemSkSize;
 };
 
-int32_t SCLOUDPLUS_SamplePsi(const uint8_t* seed, const SCLOUDPLUS_Para* para, uint16_t* matrixS);
-int32_t SCLOUDPLUS_SamplePhi(const uint8_t* seed, const SCLOUDPLUS_Para* para, uint16_t* matrixs);
-int32_t SCLOUDPLUS_SampleEta1(const uint8_t* seed, const SCLOUDPLUS_Para* para, uint16_t* matrixE);
-int32_t SCLOUDPLUS_SampleEta2(const uint8_t* seed, const SCLOUDPLUS_Para* para, uint16_t* matrixE1, uint16_t* matrixE2);
-int32_t SCLOUDPLUS_AS_E(const uint8_t* seedA, const uint16_t* S,
-                        const uint16_t* E, const SCLOUDPLUS_Para* para, uint16_t* B);
-int32_t SCLOUDPLUS_SA_E(const uint8_t* seedA, const uint16_t* S,
-                        uint16_t* E, const SCLOUDPLUS_Para* para, uint16_t* C);
+int32_t SCLOUDPLUS_SamplePsi(const uint8_t* seed, const SCLOUDPLUS_Para* para, CRYPT_EAL_MdCtx* psiCtx,
+                             uint16_t* matrixS);
+int32_t SCLOUDPLUS_SamplePhi(const uint8_t* seed, const SCLOUDPLUS_Para* para, CRYPT_EAL_MdCtx* phiCtx,
+                             uint16_t* matrixs);
+int32_t SCLOUDPLUS_SampleEta1(const uint8_t* seed, const SCLOUDPLUS_Para* para, CRYPT_EAL_MdCtx* mdCtx,
+                              uint16_t* matrixE);
+int32_t SCLOUDPLUS_SampleEta2(const uint8_t* seed, const SCLOUDPLUS_Para* para, CRYPT_EAL_MdCtx* mdCtx,
+                              uint16_t* matrixE1, uint16_t* matrixE2);
+int32_t SCLOUDPLUS_TernaryCheck(const uint16_t* S, const uint16_t rows, const uint16_t cols, const uint16_t h);
+// 以下矩阵运算函数的tmp为调用者提供的临时空间，长度不小于SCLOUDPLUS_KernelTmpLen个uint16_t
+uint32_t SCLOUDPLUS_KernelTmpLen(const SCLOUDPLUS_Para* para);
+// 仅处理矩阵A的[rowBegin, rowEnd)行（均为8的倍数），B需预先填入E
+int32_t SCLOUDPLUS_AS_E_Rows(const uint8_t* seedA, const uint16_t* S, const SCLOUDPLUS_Para* para,
+                             const uint32_t rowBegin, const uint32_t rowEnd, uint16_t* B, uint16_t* tmp);
+// 仅将矩阵A的[rowBegin, rowEnd)行（均为8的倍数）对应的部分累加到E；num（不超过SCLOUDPLUS_ENCAPS_BATCH_MAX）
+// 组S/E共用一次矩阵A的展开，第b组分别位于S + b * mbar * m、E + b * mbar * n
+int32_t SCLOUDPLUS_SA_E_Rows(const uint8_t* seedA, const uint16_t* cacheA, const uint32_t cacheRows,
+                             const uint32_t num, const uint16_t* S, uint16_t* E, const SCLOUDPLUS_Para* para,
+                             const uint32_t rowBegin, const uint32_t rowEnd, uint16_t* tmp);
+#ifdef SCLOUDPLUS_AES_NATIVE
+// seedA展开的AES-128轮密钥，供直接调用AES指令展开矩阵A
+typedef struct {
+    uint8_t rk[11][16];
+} SCLOUDPLUS_AesKey;
+
+void SCLOUDPLUS_AesKeyInit(const uint8_t* seedA, SCLOUDPLUS_AesKey* key);
+// 生成第row行起的rowNum行，按行存放
+void SCLOUDPLUS_AesGenRows(const SCLOUDPLUS_AesKey* key, const SCLOUDPLUS_Para* para, const uint32_t row,
+                           const uint32_t rowNum, uint16_t* out);
+// 生成第row行起的8行并转置：outT[k * 8 + r] = A[row + r][k]
+void SCLOUDPLUS_AesGenRowsT(const SCLOUDPLUS_AesKey* key, const SCLOUDPLUS_Para* para, const uint32_t row,
+                            uint16_t* outT);
+#endif
+
+int32_t SCLOUDPLUS_ExpandA(const uint8_t* seedA, const SCLOUDPLUS_Para* para, const uint32_t rowNum, uint16_t* A,
+                           uint16_t* tmp);
 void SCLOUDPLUS_SB_E(const uint16_t* S, const uint16_t* B,
                      const uint16_t* E, const SCLOUDPLUS_Para* para, uint16_t* out);
-void SCLOUDPLUS_CS(const uint16_t* C, const uint16_t* S, const SCLOUDPLUS_Para* para, uint16_t* out);
+void SCLOUDPLUS_CS(const uint16_t* C, const uint16_t* S, const SCLOUDPLUS_Para* para, uint16_t* out,
+                   uint16_t* tmp);
 void SCLOUDPLUS_Add(const uint16_t* in0, const uint16_t* in1, const int len, uint16_t* out);
 void SCLOUDPLUS_Sub(const uint16_t* in0, const uint16_t* in1, const int len, uint16_t* out);
 void SCLOUDPLUS_PackPK(const uint16_t* B, const SCLOUDPLUS_Para* para, uint8_t* pk);
 void SCLOUDPLUS_UnPackPK(const uint8_t* pk, const SCLOUDPLUS_Para* para, uint16_t* B);
 void SCLOUDPLUS_PackSK(const uint16_t* S, const SCLOUDPLUS_Para* para, uint8_t* sk);
 void SCLOUDPLUS_UnPackSK(const uint8_t* sk, const SCLOUDPLUS_Para* para, uint16_t* S);
-void SCLOUDPLUS_CompressC1(const uint16_t* C, const SCLOUDPLUS_Para* para, uint16_t* out);
-void SCLOUDPLUS_DeCompressC1(const uint16_t* in, const SCLOUDPLUS_Para* para, uint16_t* C);
-void SCLOUDPLUS_CompressC2(const uint16_t* C, const SCLOUDPLUS_Para* para, uint16_t* out);
-void SCLOUDPLUS_DeCompressC2(const uint16_t* in, const SCLOUDPLUS_Para* para, uint16_t* C);
-void SCLOUDPLUS_PackC1(const uint16_t* C, const SCLOUDPLUS_Para* para, uint8_t* out);
-void SCLOUDPLUS_UnPackC1(const uint8_t* in, const SCLOUDPLUS_Para* para, uint16_t* C);
-void SCLOUDPLUS_PackC2(const uint16_t* C, const SCLOUDPLUS_Para* para, uint8_t* out);
-void SCLOUDPLUS_UnPackC2(const uint8_t* in, const SCLOUDPLUS_Para* para, uint16_t* C);
+// 压缩并打包C1/C2至密文，及其逆过程（解包并解压缩），各为对矩阵的单遍处理
+void SCLOUDPLUS_CompressPackC1(const uint16_t* C, const SCLOUDPLUS_Para* para, uint8_t* out);
+void SCLOUDPLUS_UnPackDeCompressC1(const uint8_t* in, const SCLOUDPLUS_Para* para, uint16_t* C);
+void SCLOUDPLUS_CompressPackC2(const uint16_t* C, const SCLOUDPLUS_Para* para, uint8_t* out);
+void SCLOUDPLUS_UnPackDeCompressC2(const uint8_t* in, const SCLOUDPLUS_Para* para, uint16_t* C);
+// 压缩打包后与密文ct中对应部分比较，返回各字节差异的按位或（0表示一致），逐块比较而不保存整个打包结果
+uint8_t SCLOUDPLUS_CompressCmpC1(const uint16_t* C, const SCLOUDPLUS_Para* para, const uint8_t* ct);
+uint8_t SCLOUDPLUS_CompressCmpC2(const uint16_t* C, const SCLOUDPLUS_Para* para, const uint8_t* ct);
+
+/*
+ * 热点矩阵运算与打包函数表，各成员与同名的SCLOUDPLUS_*通用实现签名一致。
+ * 预定义参数集使用以编译期常量参数集实例化的版本，定义SCLOUDPLUS_GENERIC_KERNELS时统一使用通用实现。
+ */
+struct SCLOUDPLUSKernels {
+    int32_t (*asERows)(const uint8_t* seedA, const uint16_t* S, const SCLOUDPLUS_Para* para,
+                       const uint32_t rowBegin, const uint32_t rowEnd, uint16_t* B, uint16_t* tmp);
+    int32_t (*saERows)(const uint8_t* seedA, const uint16_t* cacheA, const uint32_t cacheRows, const uint32_t num,
+                       const uint16_t* S, uint16_t* E, const SCLOUDPLUS_Para* para, const uint32_t rowBegin,
+                       const uint32_t rowEnd, uint16_t* tmp);
+    void (*cs)(const uint16_t* C, const uint16_t* S, const SCLOUDPLUS_Para* para, uint16_t* out, uint16_t* tmp);
+    void (*sbE)(const uint16_t* S, const uint16_t* B, const uint16_t* E, const SCLOUDPLUS_Para* para,
+                uint16_t* out);
+    void (*packPK)(const uint16_t* B, const SCLOUDPLUS_Para* para, uint8_t* pk);
+    void (*unPackPK)(const uint8_t* pk, const SCLOUDPLUS_Para* para, uint16_t* B);
+    void (*packSK)(const uint16_t* S, const SCLOUDPLUS_Para* para, uint8_t* sk);
+    void (*unPackSK)(const uint8_t* sk, const SCLOUDPLUS_Para* para, uint16_t* S);
+    void (*compressPackC1)(const uint16_t* C, const SCLOUDPLUS_Para* para, uint8_t* out);
+    void (*unPackDeCompressC1)(const uint8_t* in, const SCLOUDPLUS_Para* para, uint16_t* C);
+    void (*compressPackC2)(const uint16_t* C, const SCLOUDPLUS_Para* para, uint8_t* out);
+    void (*unPackDeCompressC2)(const uint8_t* in, const SCLOUDPLUS_Para* para, uint16_t* C);
+    uint8_t (*compressCmpC1)(const uint16_t* C, const SCLOUDPLUS_Para* para, const uint8_t* ct);
+    uint8_t (*compressCmpC2)(const uint16_t* C, const SCLOUDPLUS_Para* para, const uint8_t* ct);
+};
+
+// 预定义参数集，set无效时返回NULL
+const SCLOUDPLUS_Para* SCLOUDPLUS_GetPara(const SCLOUDPLUS_PARA_SET set);
+// 参数集对应的函数表，没有特化版本时返回通用实现
+const SCLOUDPLUS_Kernels* SCLOUDPLUS_GetKernels(const SCLOUDPLUS_PARA_SET set);
 
 void SCLOUDPLUS_MsgEncode(const uint8_t* msg, const SCLOUDPLUS_Para* para, uint16_t* matrixM);
 int32_t SCLOUDPLUS_MsgDecode(const uint16_t* matrixM, const SCLOUDPLUS_Para* para, uint8_t* msg);
 
-int8_t SCLOUDPLUS_Verify(const uint8_t* a, const uint8_t* b, const int Len);
+int32_t SCLOUDPLUS_MdCtxFunc(CRYPT_EAL_MdCtx* MdCtx, const uint8_t* input1, const uint32_t inLen1,
+                             const uint8_t* input2, const uint32_t inLen2, uint8_t* output, uint32_t* outLen);
 int32_t SCLOUDPLUS_MdFunc(const CRYPT_MD_AlgId id, const uint8_t* input1, const uint32_t inLen1, const uint8_t* input2,
                           const uint32_t inLen2,
                           uint8_t* output, uint32_t* outLen);
@@ -23,6 +23,63 @@
 #include "pqcp_err.h"
 #include "crypt_utils.h"
 
+/*
+ * 矩阵乘法内核的向量化实现：按编译目标选择AVX-512BW/AVX2/SSE2/NEON，均为16位逐元素乘加（模2^16），
+ * 与标量实现结果逐位一致；不支持时退回标量循环。
+ * SIMD_*为128位（8个uint16）操作，SIMD_WIDE_*为当前目标可用的最宽向量。
+ */
+#if defined(__SSE2__)
+#include <immintrin.h>
+
+#define SCLOUDPLUS_SIMD
+#define SIMD_LOAD(x)     _mm_loadu_si128((const __m128i *)(x))
+#define SIMD_STORE(x, y) _mm_storeu_si128((__m128i *)(x), (y))
+#define SIMD_ADD(x, y)   _mm_add_epi16((x), (y))
+#define SIMD_SUB(x, y)   _mm_sub_epi16((x), (y))
+#define SIMD_MUL(x, y)   _mm_mullo_epi16((x), (y))
+#define SIMD_SET1(x)     _mm_set1_epi16((int16_t)(x))
+#define SIMD_ZERO()      _mm_setzero_si128()
+typedef __m128i SimdVec;
+
+#if defined(__AVX512BW__)
+#define SCLOUDPLUS_SIMD_WIDE 32
+#define SIMD_WIDE_LOAD(x)     _mm512_loadu_si512((const void *)(x))
+#define SIMD_WIDE_STORE(x, y) _mm512_storeu_si512((void *)(x), (y))
+#define SIMD_WIDE_ADD(x, y)   _mm512_add_epi16((x), (y))
+#define SIMD_WIDE_SUB(x, y)   _mm512_sub_epi16((x), (y))
+#define SIMD_WIDE_MUL(x, y)   _mm512_mullo_epi16((x), (y))
+#define SIMD_WIDE_SET1(x)     _mm512_set1_epi16((int16_t)(x))
+typedef __m512i SimdWideVec;
+#elif defined(__AVX2__)
+#define SCLOUDPLUS_SIMD_WIDE 16
+#define SIMD_WIDE_LOAD(x)     _mm256_loadu_si256((const __m256i *)(x))
+#define SIMD_WIDE_STORE(x, y) _mm256_storeu_si256((__m256i *)(x), (y))
+#define SIMD_WIDE_ADD(x, y)   _mm256_add_epi16((x), (y))
+#define SIMD_WIDE_SUB(x, y)   _mm256_sub_epi16((x), (y))
+#define SIMD_WIDE_MUL(x, y)   _mm256_mullo_epi16((x), (y))
+#define SIMD_WIDE_SET1(x)     _mm256_set1_epi16((int16_t)(x))
+typedef __m256i SimdWideVec;
+#endif
+
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+
+#define SCLOUDPLUS_SIMD
+#define SIMD_LOAD(x)     vld1q_u16((const uint16_t *)(x))
+#define SIMD_STORE(x, y) vst1q_u16((uint16_t *)(x), (y))
+#define SIMD_ADD(x, y)   vaddq_u16((x), (y))
+#define SIMD_SUB(x, y)   vsubq_u16((x), (y))
+#define SIMD_MUL(x, y)   vmulq_u16((x), (y))
+#define SIMD_SET1(x)     vdupq_n_u16((uint16_t)(x))
+#define SIMD_ZERO()      vdupq_n_u16(0)
+typedef uint16x8_t SimdVec;
+#endif
+
+#define SCLOUDPLUS_SIMD_LANES 8
+
+// 内核函数强制内联到各参数集的实例中，使参数集字段成为编译期常量
+#define SCLOUDPLUS_KERNEL_INLINE __attribute__((always_inline)) static inline
+
 static inline Complex ComplexAdd(const Complex a, const Complex b)
 {
     return (Complex){a.real + b.real, a.imag + b.imag};
@@ -67,11 +124,6 @@ static inline int32_t Round(const int32_t in, const uint8_t logq, const uint8_t
     return q * mod;
 }
 
-static inline uint32_t U16ToU32(const uint16_t *ptr)
-{
-    return ((uint32_t)ptr[0]) | ((uint32_t)ptr[1] << 16);
-}
-
 static inline uint32_t U8ToU24(const uint8_t *ptr)
 {
     return ((uint32_t)ptr[0] << 0) | ((uint32_t)ptr[1] << 8) |
@@ -677,115 +729,102 @@ static inline int32_t DelabelingRecoverW(const Complex w[SCLOUDPLUS_BW_COMPLEX_L
     return DelabelingReduceW(tmp, tau, v);
 }
 
-static inline int32_t EuclideanDistanceNoSqrt(const Complex *set1, const Complex *set2, int32_t set_size)
+// |a - b|^2
+static inline int32_t ComplexDist(const Complex a, const Complex b)
 {
-    int32_t sum = 0;
-    for (int i = 0; i < set_size; i++) {
-        const int32_t realDiff = set1[i].real - set2[i].real;
-        const int32_t imagDiff = set1[i].imag - set2[i].imag;
-
-        sum += realDiff * realDiff + imagDiff * imagDiff;
-    }
-    return sum;
+    const int32_t realDiff = a.real - b.real;
+    const int32_t imagDiff = a.imag - b.imag;
+    return realDiff * realDiff + imagDiff * imagDiff;
 }
 
-static inline int32_t BDDForBWn(const Complex *t, const int32_t BWn, const uint8_t logq, const uint8_t tau, Complex *y)
+/*
+ * BW32 有界距离译码（BDD）。
+ * 长度为len的节点将t分为t1、t2两半，对t1、t2、(t2-y1)/phi、(t1-y2)/phi四个子问题译码得到y1、y2、z1、z2，
+ * 候选 (y1, y1+phi*z1) 与 (y2+phi*z2, y2) 中与t距离较小者为结果；len为1时直接取整。
+ * 递归改为显式栈迭代：深度固定为log2(16)，每层占用3*len个复数的工作区，总工作区在栈上固定分配。
+ * 候选选择使用掩码，不依赖分支。
+ */
+#define SCLOUDPLUS_BDD_DEPTH 4
+#define SCLOUDPLUS_BDD_WS_LEN (3 * (SCLOUDPLUS_BW_COMPLEX_LEN << 1))
+
+typedef struct {
+    const Complex *t; // 当前子问题输入
+    Complex *y;       // 当前子问题输出
+    Complex *ws;      // 当前层工作区：y1 | y2 | z1 | z2 | z1in | z2in
+    int32_t len;      // 复数个数
+    int32_t stage;    // 已下发的子问题个数
+} BDDFrame;
+
+static inline void BDDCombine(const BDDFrame *f)
 {
-    const int32_t tLen = BWn >> 1;
-    const int32_t halfOftLen = tLen >> 1;
+    const int32_t h = f->len >> 1;
+    const Complex *y1 = f->ws;
+    const Complex *y2 = y1 + h;
+    const Complex *z1 = y2 + h;
+    const Complex *z2 = z1 + h;
     const Complex phi = {1, 1};
-    int32_t ret = 0;
-    if (BWn == 2) {
-        y[0] = (Complex){Round(t[0].real, logq, tau), Round(t[0].imag, logq, tau)};
-        return 0;
-    }
-
-    Complex *t1 = BSL_SAL_Malloc(sizeof(Complex) * halfOftLen * 4);
-    if (t1 == NULL) {
-        return PQCP_MEM_ALLOC_FAIL;
-    }
-    Complex *t2 = t1 + halfOftLen;
-    Complex *y1 = t2 + halfOftLen;
-    Complex *y2 = y1 + halfOftLen;
-
-    for (int i = 0; i < halfOftLen; i++) {
-        t1[i] = t[i];
-        t2[i] = t[i + halfOftLen];
-    }
-    ret = BDDForBWn(t1, tLen, logq, tau, y1);
-    if (ret != 0) {
-        BSL_SAL_FREE(t1);
-        return ret;
-    }
-    ret = BDDForBWn(t2, tLen, logq, tau, y2);
-    if (ret != 0) {
-        BSL_SAL_FREE(t1);
-        return ret;
-    }
-
-    // Allocate memory for z1, z2, z1in, z2in (4 * halfOftLen)
-    Complex *z1 = BSL_SAL_Malloc(sizeof(Complex) * halfOftLen * 4);
-    if (z1 == NULL) {
-        BSL_SAL_FREE(t1);
-        return PQCP_MEM_ALLOC_FAIL;
-    }
-    Complex *z2 = z1 + halfOftLen;
-    Complex *z1in = z2 + halfOftLen;
-    Complex *z2in = z1in + halfOftLen;
-
-    for (int i = 0; i < halfOftLen; i++) {
-        z1in[i] = ComplexDivPhi(ComplexSub(t2[i], y1[i]));
-        z2in[i] = ComplexDivPhi(ComplexSub(t1[i], y2[i]));
-    }
-    ret = BDDForBWn(z1in, tLen, logq, tau, z1);
-    if (ret != 0) {
-        BSL_SAL_FREE(z1);
-        BSL_SAL_FREE(t1);
-        return ret;
-    }
-    ret = BDDForBWn(z2in, tLen, logq, tau, z2);
-    if (ret != 0) {
-        BSL_SAL_FREE(z1);
-        BSL_SAL_FREE(t1);
-        return ret;
-    }
-
-    for (int i = 0; i < halfOftLen; i++) {
-        z1[i] = ComplexMul(z1[i], phi);
-        z2[i] = ComplexMul(z2[i], phi);
-    }
-
-    Complex *out1 = BSL_SAL_Malloc(sizeof(Complex) * tLen * 2);
-    if (out1 == NULL) {
-        BSL_SAL_FREE(z1);
-        BSL_SAL_FREE(t1);
-        return PQCP_MEM_ALLOC_FAIL;
-    }
-    Complex *out2 = out1 + tLen;
-
-    for (int i = 0; i < halfOftLen; i++) {
-        out1[i] = y1[i];
-        out1[halfOftLen + i] = ComplexAdd(y1[i], z1[i]);
-        out2[i] = ComplexAdd(y2[i], z2[i]);
-        out2[halfOftLen + i] = y2[i];
-    }
-    const int32_t d1 = EuclideanDistanceNoSqrt(out1, t, tLen);
-    const int32_t d2 = EuclideanDistanceNoSqrt(out2, t, tLen);
-
-    if (d1 < d2) {
-        for (int i = 0; i < tLen; i++) {
-            y[i] = out1[i];
-        }
-    } else {
-        for (int i = 0; i < tLen; i++) {
-            y[i] = out2[i];
-        }
+    int32_t d1 = 0;
+    int32_t d2 = 0;
+    for (int32_t i = 0; i < h; i++) {
+        const Complex a = ComplexAdd(y1[i], ComplexMul(z1[i], phi));
+        const Complex b = ComplexAdd(y2[i], ComplexMul(z2[i], phi));
+        d1 += ComplexDist(y1[i], f->t[i]) + ComplexDist(a, f->t[h + i]);
+        d2 += ComplexDist(b, f->t[i]) + ComplexDist(y2[i], f->t[h + i]);
+    }
+    const int32_t mask = -(int32_t)(d1 < d2); // d1 < d2 时取 (y1, y1+phi*z1)
+    for (int32_t i = 0; i < h; i++) {
+        const Complex a = ComplexAdd(y1[i], ComplexMul(z1[i], phi));
+        const Complex b = ComplexAdd(y2[i], ComplexMul(z2[i], phi));
+        f->y[i].real = (y1[i].real & mask) | (b.real & ~mask);
+        f->y[i].imag = (y1[i].imag & mask) | (b.imag & ~mask);
+        f->y[h + i].real = (a.real & mask) | (y2[i].real & ~mask);
+        f->y[h + i].imag = (a.imag & mask) | (y2[i].imag & ~mask);
     }
+}
 
-    BSL_SAL_FREE(out1);
-    BSL_SAL_FREE(z1);
-    BSL_SAL_FREE(t1);
-    return 0;
+static void BDDForBW32(const Complex t[SCLOUDPLUS_BW_COMPLEX_LEN], const uint8_t logq, const uint8_t tau,
+    Complex y[SCLOUDPLUS_BW_COMPLEX_LEN])
+{
+    Complex ws[SCLOUDPLUS_BDD_WS_LEN];
+    BDDFrame stack[SCLOUDPLUS_BDD_DEPTH + 1];
+    int32_t sp = 0;
+    stack[0] = (BDDFrame){t, y, ws, SCLOUDPLUS_BW_COMPLEX_LEN, 0};
+    while (sp >= 0) {
+        BDDFrame *f = &stack[sp];
+        if (f->len == 1) {
+            f->y[0] = (Complex){Round(f->t[0].real, logq, tau), Round(f->t[0].imag, logq, tau)};
+            sp--;
+            continue;
+        }
+        const int32_t h = f->len >> 1;
+        Complex *sub = f->ws;              // y1 | y2 | z1 | z2
+        Complex *zin = f->ws + 2 * f->len; // z1in | z2in
+        Complex *next = zin + f->len;      // 下一层工作区
+        switch (f->stage++) {
+            case 0:
+                stack[sp + 1] = (BDDFrame){f->t, sub, next, h, 0};
+                break;
+            case 1:
+                stack[sp + 1] = (BDDFrame){f->t + h, sub + h, next, h, 0};
+                break;
+            case 2:
+                for (int32_t i = 0; i < h; i++) {
+                    zin[i] = ComplexDivPhi(ComplexSub(f->t[h + i], sub[i]));
+                    zin[h + i] = ComplexDivPhi(ComplexSub(f->t[i], sub[h + i]));
+                }
+                stack[sp + 1] = (BDDFrame){zin, sub + 2 * h, next, h, 0};
+                break;
+            case 3:
+                stack[sp + 1] = (BDDFrame){zin + h, sub + 3 * h, next, h, 0};
+                break;
+            default:
+                BDDCombine(f);
+                sp--;
+                continue;
+        }
+        sp++;
+    }
+    BSL_SAL_CleanseData(ws, sizeof(ws));
 }
 
 void SCLOUDPLUS_MsgEncode(const uint8_t *msg, const SCLOUDPLUS_Para *para, uint16_t *matrixM)
@@ -805,7 +844,6 @@ void SCLOUDPLUS_MsgEncode(const uint8_t *msg, const SCLOUDPLUS_Para *para, uint1
 
 int32_t SCLOUDPLUS_MsgDecode(const uint16_t *matrixM, const SCLOUDPLUS_Para *para, uint8_t *msg)
 {
-    int32_t ret = PQCP_SUCCESS;
     uint8_t *msgPtr = msg;
     Complex encMsg[SCLOUDPLUS_BW_COMPLEX_LEN], w[SCLOUDPLUS_BW_COMPLEX_LEN], u[SCLOUDPLUS_BW_COMPLEX_LEN];
     uint32_t bwNLen = SCLOUDPLUS_BW_COMPLEX_LEN << 1;
@@ -815,327 +853,539 @@ int32_t SCLOUDPLUS_MsgDecode(const uint16_t *matrixM, const SCLOUDPLUS_Para *par
             w[j] = (Complex){0, 0};
             u[j] = (Complex){0, 0};
         }
-        RETURN_RET_IF_ERR(BDDForBWn(encMsg, bwNLen, para->logq, para->tau, w), ret);
+        BDDForBW32(encMsg, para->logq, para->tau, w);
         DelabelingRecoverW(w, para->logq, para->tau, u);
         DelabelingComputeU(u, para->tau, msgPtr);
         msgPtr += (para->mu >> 3);
     }
-    return ret;
+    return PQCP_SUCCESS;
 }
 
-void SCLOUDPLUS_PackPK(const uint16_t *B, const SCLOUDPLUS_Para *para, uint8_t *pk)
+/*
+ * 位打包内核：按16个元素一组向量化（x86为SSE2，12位格式需要SSSE3；ARM为NEON），
+ * 不足一组的部分及不支持的目标使用标量实现，两者输出逐位一致。
+ * 9/10/7位格式带shift参数，在打包的同一遍内完成压缩：x -> ((x mod q) + 2^(shift-1)) >> shift，
+ * 解包时左移shift位即为解压缩；shift为0时按原值打包/解包。
+ */
+static inline uint16_t Compress(const uint16_t x, const uint8_t shift)
 {
-    const uint16_t *ptrIn = B;
-    uint8_t *ptrOut = pk;
-    uint32_t temp = 0;
+    return (uint16_t)(((x & SCLOUDPLUS_MOD_Q) + ((1 << shift) >> 1)) >> shift);
+}
 
-    for (int i = 0; i < para->m * para->nbar; i = i + 2) {
-        temp = U16ToU32(ptrIn);
-        temp = (temp & 0xFFF) ^ ((temp >> 4) & 0xFFF000);
-        ptrOut[0] = temp & 0xFF;
-        ptrOut[1] = (temp >> 8) & 0xFF;
-        ptrOut[2] = (temp >> 16) & 0xFF;
-        ptrIn = ptrIn + 2;
-        ptrOut = ptrOut + 3;
-    }
+#if defined(__SSE2__)
+#define COMPRESS_SSE2(x, mod, round, count) _mm_srl_epi16(_mm_add_epi16(_mm_and_si128((x), (mod)), (round)), (count))
+
+// 16个元素的2位字段（已在低2位）按weight加权后每4个合成1字节，返回4字节（小端）
+static inline uint32_t PackCrumbs(const __m128i a, const __m128i b, const __m128i weight)
+{
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i pa = _mm_madd_epi16(_mm_mullo_epi16(a, weight), one);
+    const __m128i pb = _mm_madd_epi16(_mm_mullo_epi16(b, weight), one);
+    const __m128i s = _mm_madd_epi16(_mm_packs_epi32(pa, pb), one);
+    return (uint32_t)_mm_cvtsi128_si32(_mm_packus_epi16(_mm_packs_epi32(s, s), _mm_setzero_si128()));
 }
 
-void SCLOUDPLUS_UnPackPK(const uint8_t *pk, const SCLOUDPLUS_Para *para, uint16_t *B)
+// 将4字节h0..h3展开为16位通道：lo为h0、h1各重复4次，hi为h2、h3各重复4次（每个通道为h * 257）
+static inline void SpreadCrumbs(const uint8_t *in, __m128i *lo, __m128i *hi)
 {
-    const uint8_t *ptrIn = pk;
-    uint16_t *ptrOut = B;
-    for (int i = 0; i < para->m * para->nbar; i = i + 2) {
-        *ptrOut = *(uint16_t *)ptrIn & SCLOUDPLUS_MOD_Q;
-        *(ptrOut + 1) = (*(uint16_t *)(ptrIn + 1) >> 4) & SCLOUDPLUS_MOD_Q;
-        ptrIn = ptrIn + 3;
-        ptrOut = ptrOut + 2;
-    }
+    __m128i v = _mm_cvtsi32_si128((int32_t)U8ToU32(in));
+    v = _mm_unpacklo_epi8(v, v);
+    v = _mm_unpacklo_epi16(v, v);
+    *lo = _mm_unpacklo_epi32(v, v);
+    *hi = _mm_unpackhi_epi32(v, v);
 }
+#elif defined(__ARM_NEON)
+#define COMPRESS_NEON(x, mod, round, count) vshlq_u16(vaddq_u16(vandq_u16((x), (mod)), (round)), (count))
 
-void SCLOUDPLUS_PackSK(const uint16_t *S, const SCLOUDPLUS_Para *para, uint8_t *sk)
+// 将8个通道的值按bitPos左移后两两相加，返回前4个与后4个通道之和
+static inline uint64x2_t PackLanes(const uint16x8_t x, const int16_t bitPos[8])
 {
-    const uint16_t *ptrIn = S;
-    uint8_t *ptrOut = sk;
-    uint8_t temp = 0;
-    for (int i = 0; i < para->n * para->nbar; i = i + 4) {
-        temp = (*ptrIn & 0x03);
-        temp = ((*(ptrIn + 1) << 2) & 0x0C) ^ temp;
-        temp = ((*(ptrIn + 2) << 4) & 0x30) ^ temp;
-        temp = ((*(ptrIn + 3) << 6) & 0xC0) ^ temp;
-        *ptrOut = temp;
-        ptrIn = ptrIn + 4;
-        ptrOut = ptrOut + 1;
-    }
+    return vpaddlq_u32(vpaddlq_u16(vshlq_u16(x, vld1q_s16(bitPos))));
 }
 
-void SCLOUDPLUS_UnPackSK(const uint8_t *sk, const SCLOUDPLUS_Para *para, uint16_t *S)
+// 低4个通道为h0，高4个通道为h1
+static inline uint16x8_t SpreadByte2(const uint8_t h0, const uint8_t h1)
 {
-    const uint8_t *ptrIn = sk;
-    uint16_t *ptrOut = S;
-    uint8_t temp = 0;
-    for (int i = 0; i < para->n * para->nbar; i = i + 4) {
-        temp = *ptrIn;
-        *ptrOut = (int16_t)((temp & 0x03) << 14) >> 14;
-        *(ptrOut + 1) = (int16_t)(((temp >> 2) & 0x03) << 14) >> 14;
-        *(ptrOut + 2) = (int16_t)(((temp >> 4) & 0x03) << 14) >> 14;
-        *(ptrOut + 3) = (int16_t)(((temp >> 6) & 0x03) << 14) >> 14;
-        ptrIn = ptrIn + 1;
-        ptrOut = ptrOut + 4;
+    return vcombine_u16(vdup_n_u16(h0), vdup_n_u16(h1));
+}
+#endif
+
+/*
+ * 9位格式：前len字节为各元素低8位，其后每字节依次存放8个元素的第8位（首个元素在最高位）。
+ * len为8的倍数。
+ */
+SCLOUDPLUS_KERNEL_INLINE void PackBits9(const uint16_t *in, const int len, const uint8_t shift, uint8_t *out)
+{
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i lowMask = _mm_set1_epi16(0xFF);
+    const __m128i mod = _mm_set1_epi16(SCLOUDPLUS_MOD_Q);
+    const __m128i round = _mm_set1_epi16((1 << shift) >> 1);
+    const __m128i count = _mm_cvtsi32_si128(shift);
+    for (; i + 16 <= len; i += 16) {
+        const __m128i a = COMPRESS_SSE2(_mm_loadu_si128((const __m128i *)(in + i)), mod, round, count);
+        const __m128i b = COMPRESS_SSE2(_mm_loadu_si128((const __m128i *)(in + i + 8)), mod, round, count);
+        _mm_storeu_si128((__m128i *)(out + i), _mm_packus_epi16(_mm_and_si128(a, lowMask), _mm_and_si128(b, lowMask)));
+        // 逆序通道后第8位移到符号位，movemask第k位即为第7-k个元素
+        __m128i ra = _mm_shufflehi_epi16(_mm_shufflelo_epi16(a, 0x1B), 0x1B);
+        __m128i rb = _mm_shufflehi_epi16(_mm_shufflelo_epi16(b, 0x1B), 0x1B);
+        ra = _mm_slli_epi16(_mm_shuffle_epi32(ra, 0x4E), 7);
+        rb = _mm_slli_epi16(_mm_shuffle_epi32(rb, 0x4E), 7);
+        const int bits = _mm_movemask_epi8(_mm_packs_epi16(ra, rb));
+        out[len + i / 8] = (uint8_t)bits;
+        out[len + i / 8 + 1] = (uint8_t)(bits >> 8);
+    }
+#elif defined(__ARM_NEON)
+    static const int16_t bitPos[8] = {7, 6, 5, 4, 3, 2, 1, 0};
+    const uint16x8_t mod = vdupq_n_u16(SCLOUDPLUS_MOD_Q);
+    const uint16x8_t round = vdupq_n_u16((1 << shift) >> 1);
+    const int16x8_t count = vdupq_n_s16(-(int16_t)shift);
+    for (; i + 16 <= len; i += 16) {
+        const uint16x8_t a = COMPRESS_NEON(vld1q_u16(in + i), mod, round, count);
+        const uint16x8_t b = COMPRESS_NEON(vld1q_u16(in + i + 8), mod, round, count);
+        vst1q_u8(out + i, vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+        const uint64x2_t ha = PackLanes(vandq_u16(vshrq_n_u16(a, 8), vdupq_n_u16(1)), bitPos);
+        const uint64x2_t hb = PackLanes(vandq_u16(vshrq_n_u16(b, 8), vdupq_n_u16(1)), bitPos);
+        out[len + i / 8] = (uint8_t)(vgetq_lane_u64(ha, 0) + vgetq_lane_u64(ha, 1));
+        out[len + i / 8 + 1] = (uint8_t)(vgetq_lane_u64(hb, 0) + vgetq_lane_u64(hb, 1));
+    }
+#endif
+    for (; i < len; i += 8) {
+        uint8_t hi = 0;
+        for (int j = 0; j < 8; j++) {
+            const uint16_t x = Compress(in[i + j], shift);
+            out[i + j] = (uint8_t)x;
+            hi = (uint8_t)((hi << 1) | ((x >> 8) & 0x01));
+        }
+        out[len + i / 8] = hi;
     }
 }
 
-//compress函数类似于KYBER
-void SCLOUDPLUS_CompressC1(const uint16_t *C, const SCLOUDPLUS_Para *para, uint16_t *out)
+SCLOUDPLUS_KERNEL_INLINE void UnPackBits9(const uint8_t *in, const int len, const uint8_t shift, uint16_t *out)
 {
-    if (para->ss == 16) {
-        for (int i = 0; i < para->mbar * para->n; i++) {
-            out[i] = ((((uint32_t)(C[i] & SCLOUDPLUS_MOD_Q) << 9) + 2048) >> 12) & 0x1FF;
-        }
-    } else if (para->ss == 24) {
-        memcpy(out, C, para->mbar * para->n * sizeof(uint16_t));
-    } else if (para->ss == 32) {
-        for (int i = 0; i < para->mbar * para->n; i++) {
-            out[i] = ((((uint32_t)(C[i] & SCLOUDPLUS_MOD_Q) << 10) + 2048) >> 12) & 0x3FF;
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i count = _mm_cvtsi32_si128(shift);
+    const __m128i weight = _mm_setr_epi16(2, 4, 8, 16, 32, 64, 128, 256);
+    const __m128i hiMask = _mm_set1_epi16(0x100);
+    for (; i + 16 <= len; i += 16) {
+        const __m128i lo = _mm_loadu_si128((const __m128i *)(in + i));
+        __m128i h = _mm_cvtsi32_si128(in[len + i / 8] | (in[len + i / 8 + 1] << 8));
+        h = _mm_unpacklo_epi8(h, h);
+        h = _mm_unpacklo_epi16(h, h);
+        const __m128i ha = _mm_and_si128(_mm_mullo_epi16(_mm_shuffle_epi32(h, 0x00), weight), hiMask);
+        const __m128i hb = _mm_and_si128(_mm_mullo_epi16(_mm_shuffle_epi32(h, 0x55), weight), hiMask);
+        const __m128i a = _mm_or_si128(_mm_unpacklo_epi8(lo, _mm_setzero_si128()), ha);
+        const __m128i b = _mm_or_si128(_mm_unpackhi_epi8(lo, _mm_setzero_si128()), hb);
+        _mm_storeu_si128((__m128i *)(out + i), _mm_sll_epi16(a, count));
+        _mm_storeu_si128((__m128i *)(out + i + 8), _mm_sll_epi16(b, count));
+    }
+#elif defined(__ARM_NEON)
+    static const int16_t bitPos[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    const int16x8_t s = vld1q_s16(bitPos);
+    const int16x8_t count = vdupq_n_s16((int16_t)shift);
+    for (; i + 16 <= len; i += 16) {
+        const uint8x16_t lo = vld1q_u8(in + i);
+        const uint16x8_t ha = vandq_u16(vshlq_u16(vdupq_n_u16(in[len + i / 8]), s), vdupq_n_u16(0x100));
+        const uint16x8_t hb = vandq_u16(vshlq_u16(vdupq_n_u16(in[len + i / 8 + 1]), s), vdupq_n_u16(0x100));
+        vst1q_u16(out + i, vshlq_u16(vorrq_u16(vmovl_u8(vget_low_u8(lo)), ha), count));
+        vst1q_u16(out + i + 8, vshlq_u16(vorrq_u16(vmovl_u8(vget_high_u8(lo)), hb), count));
+    }
+#endif
+    for (; i < len; i += 8) {
+        const uint16_t hi = in[len + i / 8];
+        for (int j = 0; j < 8; j++) {
+            out[i + j] = (uint16_t)(((uint16_t)in[i + j] | ((hi << (j + 1)) & 0x100)) << shift);
         }
     }
 }
 
-void SCLOUDPLUS_DeCompressC1(const uint16_t *in, const SCLOUDPLUS_Para *para, uint16_t *C)
+/*
+ * 10位格式：前len字节为各元素低8位，其后每字节依次存放4个元素的第8、9位（首个元素在最高2位）。
+ * len为4的倍数。
+ */
+SCLOUDPLUS_KERNEL_INLINE void PackBits10(const uint16_t *in, const int len, const uint8_t shift, uint8_t *out)
 {
-    if (para->ss == 16) {
-        for (int i = 0; i < para->mbar * para->n; i++) {
-            C[i] = ((uint32_t)((in[i] & 0x1FF) << 12) + 256) >> 9;
-        }
-    } else if (para->ss == 24) {
-        memcpy(C, in, para->mbar * para->n * sizeof(uint16_t));
-    } else if (para->ss == 32) {
-        for (int i = 0; i < para->mbar * para->n; i++) {
-            C[i] = ((uint32_t)((in[i] & 0x3FF) << 12) + 512) >> 10;
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i lowMask = _mm_set1_epi16(0xFF);
+    const __m128i weight = _mm_setr_epi16(64, 16, 4, 1, 64, 16, 4, 1);
+    const __m128i crumbMask = _mm_set1_epi16(0x03);
+    const __m128i mod = _mm_set1_epi16(SCLOUDPLUS_MOD_Q);
+    const __m128i round = _mm_set1_epi16((1 << shift) >> 1);
+    const __m128i count = _mm_cvtsi32_si128(shift);
+    for (; i + 16 <= len; i += 16) {
+        const __m128i a = COMPRESS_SSE2(_mm_loadu_si128((const __m128i *)(in + i)), mod, round, count);
+        const __m128i b = COMPRESS_SSE2(_mm_loadu_si128((const __m128i *)(in + i + 8)), mod, round, count);
+        _mm_storeu_si128((__m128i *)(out + i), _mm_packus_epi16(_mm_and_si128(a, lowMask), _mm_and_si128(b, lowMask)));
+        const uint32_t hi = PackCrumbs(_mm_and_si128(_mm_srli_epi16(a, 8), crumbMask),
+                                       _mm_and_si128(_mm_srli_epi16(b, 8), crumbMask), weight);
+        memcpy(out + len + i / 4, &hi, sizeof(hi));
+    }
+#elif defined(__ARM_NEON)
+    static const int16_t bitPos[8] = {6, 4, 2, 0, 6, 4, 2, 0};
+    const uint16x8_t mod = vdupq_n_u16(SCLOUDPLUS_MOD_Q);
+    const uint16x8_t round = vdupq_n_u16((1 << shift) >> 1);
+    const int16x8_t count = vdupq_n_s16(-(int16_t)shift);
+    for (; i + 16 <= len; i += 16) {
+        const uint16x8_t a = COMPRESS_NEON(vld1q_u16(in + i), mod, round, count);
+        const uint16x8_t b = COMPRESS_NEON(vld1q_u16(in + i + 8), mod, round, count);
+        vst1q_u8(out + i, vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+        const uint64x2_t ha = PackLanes(vandq_u16(vshrq_n_u16(a, 8), vdupq_n_u16(0x03)), bitPos);
+        const uint64x2_t hb = PackLanes(vandq_u16(vshrq_n_u16(b, 8), vdupq_n_u16(0x03)), bitPos);
+        out[len + i / 4] = (uint8_t)vgetq_lane_u64(ha, 0);
+        out[len + i / 4 + 1] = (uint8_t)vgetq_lane_u64(ha, 1);
+        out[len + i / 4 + 2] = (uint8_t)vgetq_lane_u64(hb, 0);
+        out[len + i / 4 + 3] = (uint8_t)vgetq_lane_u64(hb, 1);
+    }
+#endif
+    for (; i < len; i += 4) {
+        uint8_t hi = 0;
+        for (int j = 0; j < 4; j++) {
+            const uint16_t x = Compress(in[i + j], shift);
+            out[i + j] = (uint8_t)x;
+            hi = (uint8_t)((hi << 2) | ((x >> 8) & 0x03));
         }
+        out[len + i / 4] = hi;
     }
 }
 
-//此函数对应论文算法5的C_2压缩时的四舍五入,针对0.5的情况要进行向奇数位的舍入,如0.5得到1, 3.5也是得到3.其他值仍为正常的四舍五入
-void SCLOUDPLUS_CompressC2(const uint16_t *C, const SCLOUDPLUS_Para *para, uint16_t *out)
+SCLOUDPLUS_KERNEL_INLINE void UnPackBits10(const uint8_t *in, const int len, const uint8_t shift, uint16_t *out)
 {
-    if (para->ss == 16 || para->ss == 32) {
-        for (int i = 0; i < para->mbar * para->nbar; i++) {
-            const uint32_t temp = ((((uint32_t)(C[i] & SCLOUDPLUS_MOD_Q) << 7) + 2048) >> 12);
-            const uint32_t remainder = (((uint32_t)(C[i] & SCLOUDPLUS_MOD_Q) << 7) + 2048) % 6144;
-            out[i] = (temp - ((!remainder) && 1)) & 0x7F;
-        }
-    } else if (para->ss == 24) {
-        for (int i = 0; i < para->mbar * para->nbar; i++) {
-            const uint32_t temp = ((((uint32_t)(C[i] & SCLOUDPLUS_MOD_Q) << 10) + 2048) >> 12);
-            const uint32_t remainder = (((uint32_t)(C[i] & SCLOUDPLUS_MOD_Q) << 10) + 2048) % 6144;
-            out[i] = (temp - ((!remainder) && 1)) & 0x3FF;
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i count = _mm_cvtsi32_si128(shift);
+    const __m128i weight = _mm_setr_epi16(4, 16, 64, 256, 4, 16, 64, 256);
+    const __m128i hiMask = _mm_set1_epi16(0x300);
+    for (; i + 16 <= len; i += 16) {
+        const __m128i lo = _mm_loadu_si128((const __m128i *)(in + i));
+        __m128i ha;
+        __m128i hb;
+        SpreadCrumbs(in + len + i / 4, &ha, &hb);
+        ha = _mm_and_si128(_mm_mullo_epi16(ha, weight), hiMask);
+        hb = _mm_and_si128(_mm_mullo_epi16(hb, weight), hiMask);
+        const __m128i a = _mm_or_si128(_mm_unpacklo_epi8(lo, _mm_setzero_si128()), ha);
+        const __m128i b = _mm_or_si128(_mm_unpackhi_epi8(lo, _mm_setzero_si128()), hb);
+        _mm_storeu_si128((__m128i *)(out + i), _mm_sll_epi16(a, count));
+        _mm_storeu_si128((__m128i *)(out + i + 8), _mm_sll_epi16(b, count));
+    }
+#elif defined(__ARM_NEON)
+    static const int16_t bitPos[8] = {2, 4, 6, 8, 2, 4, 6, 8};
+    const int16x8_t s = vld1q_s16(bitPos);
+    const int16x8_t count = vdupq_n_s16((int16_t)shift);
+    for (; i + 16 <= len; i += 16) {
+        const uint8x16_t lo = vld1q_u8(in + i);
+        const uint8_t *h = in + len + i / 4;
+        const uint16x8_t ha = vandq_u16(vshlq_u16(SpreadByte2(h[0], h[1]), s), vdupq_n_u16(0x300));
+        const uint16x8_t hb = vandq_u16(vshlq_u16(SpreadByte2(h[2], h[3]), s), vdupq_n_u16(0x300));
+        vst1q_u16(out + i, vshlq_u16(vorrq_u16(vmovl_u8(vget_low_u8(lo)), ha), count));
+        vst1q_u16(out + i + 8, vshlq_u16(vorrq_u16(vmovl_u8(vget_high_u8(lo)), hb), count));
+    }
+#endif
+    for (; i < len; i += 4) {
+        const uint16_t hi = in[len + i / 4];
+        for (int j = 0; j < 4; j++) {
+            out[i + j] = (uint16_t)(((uint16_t)in[i + j] | ((hi << (2 * j + 2)) & 0x300)) << shift);
         }
     }
 }
 
-void SCLOUDPLUS_DeCompressC2(const uint16_t *in, const SCLOUDPLUS_Para *para, uint16_t *C)
+// 12位格式：每2个元素打包为3字节（小端），len为2的倍数
+SCLOUDPLUS_KERNEL_INLINE void PackBits12(const uint16_t *in, const int len, uint8_t *out)
 {
-    if (para->ss == 16 || para->ss == 32) {
-        for (int i = 0; i < para->mbar * para->nbar; i++) {
-            C[i] = ((uint32_t)((in[i] & 0x7F) << 12) + 64) >> 7;
-        }
-    } else if (para->ss == 24) {
-        for (int i = 0; i < para->mbar * para->nbar; i++) {
-            C[i] = ((uint32_t)((in[i] & 0x3FF) << 12) + 512) >> 10;
-        }
+    int i = 0;
+#if defined(__SSSE3__)
+    const __m128i mask = _mm_set1_epi16(SCLOUDPLUS_MOD_Q);
+    const __m128i weight = _mm_setr_epi16(1, 4096, 1, 4096, 1, 4096, 1, 4096);
+    const __m128i pick = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    for (; i + 16 <= len; i += 16) {
+        // 每个32位通道为e0 + e1 * 2^12，取其低3字节
+        __m128i a = _mm_madd_epi16(_mm_and_si128(_mm_loadu_si128((const __m128i *)(in + i)), mask), weight);
+        __m128i b = _mm_madd_epi16(_mm_and_si128(_mm_loadu_si128((const __m128i *)(in + i + 8)), mask), weight);
+        a = _mm_shuffle_epi8(a, pick);
+        b = _mm_shuffle_epi8(b, pick);
+        _mm_storeu_si128((__m128i *)(out + i / 2 * 3), _mm_or_si128(a, _mm_slli_si128(b, 12)));
+        _mm_storel_epi64((__m128i *)(out + i / 2 * 3 + 16), _mm_srli_si128(b, 4));
+    }
+#elif defined(__ARM_NEON)
+    const uint16x8_t mask = vdupq_n_u16(SCLOUDPLUS_MOD_Q);
+    for (; i + 16 <= len; i += 16) {
+        const uint16x8x2_t e = vld2q_u16(in + i);
+        const uint16x8_t e0 = vandq_u16(e.val[0], mask);
+        const uint16x8_t e1 = vandq_u16(e.val[1], mask);
+        uint8x8x3_t b;
+        b.val[0] = vmovn_u16(e0);
+        b.val[1] = vmovn_u16(vorrq_u16(vshrq_n_u16(e0, 8), vshlq_n_u16(e1, 4)));
+        b.val[2] = vmovn_u16(vshrq_n_u16(e1, 4));
+        vst3_u8(out + i / 2 * 3, b);
+    }
+#endif
+    for (; i < len; i += 2) {
+        const uint32_t temp = (in[i] & SCLOUDPLUS_MOD_Q) | ((uint32_t)(in[i + 1] & SCLOUDPLUS_MOD_Q) << 12);
+        out[i / 2 * 3] = (uint8_t)temp;
+        out[i / 2 * 3 + 1] = (uint8_t)(temp >> 8);
+        out[i / 2 * 3 + 2] = (uint8_t)(temp >> 16);
     }
 }
 
-void SCLOUDPLUS_PackC1(const uint16_t *C, const SCLOUDPLUS_Para *para, uint8_t *out)
+SCLOUDPLUS_KERNEL_INLINE void UnPackBits12(const uint8_t *in, const int len, uint16_t *out)
 {
-    if (para->ss == 16) {
-        const int inLen = para->mbar * para->n;
-        const uint8_t *ptrIn = (uint8_t *)C;
-        for (int i = 0; i < inLen; i++) {
-            out[i] = ptrIn[2 * i];
+    int i = 0;
+#if defined(__SSSE3__)
+    const __m128i spread0 = _mm_setr_epi8(0, 1, 1, 2, 3, 4, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11);
+    const __m128i spread1 = _mm_setr_epi8(4, 5, 5, 6, 7, 8, 8, 9, 10, 11, 11, 12, 13, 14, 14, 15);
+    const __m128i weight = _mm_setr_epi16(16, 1, 16, 1, 16, 1, 16, 1);
+    for (; i + 16 <= len; i += 16) {
+        // 偶数元素左移4位去掉高位后与奇数元素统一右移4位
+        const uint8_t *p = in + i / 2 * 3;
+        __m128i a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)p), spread0);
+        __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(p + 8)), spread1);
+        a = _mm_srli_epi16(_mm_mullo_epi16(a, weight), 4);
+        b = _mm_srli_epi16(_mm_mullo_epi16(b, weight), 4);
+        _mm_storeu_si128((__m128i *)(out + i), a);
+        _mm_storeu_si128((__m128i *)(out + i + 8), b);
+    }
+#elif defined(__ARM_NEON)
+    for (; i + 16 <= len; i += 16) {
+        const uint8x8x3_t b = vld3_u8(in + i / 2 * 3);
+        const uint16x8_t b1 = vmovl_u8(b.val[1]);
+        uint16x8x2_t e;
+        e.val[0] = vorrq_u16(vmovl_u8(b.val[0]), vshlq_n_u16(vandq_u16(b1, vdupq_n_u16(0x0F)), 8));
+        e.val[1] = vorrq_u16(vshrq_n_u16(b1, 4), vshlq_n_u16(vmovl_u8(b.val[2]), 4));
+        vst2q_u16(out + i, e);
+    }
+#endif
+    for (; i < len; i += 2) {
+        const uint32_t temp = U8ToU24(in + i / 2 * 3);
+        out[i] = temp & SCLOUDPLUS_MOD_Q;
+        out[i + 1] = (temp >> 12) & SCLOUDPLUS_MOD_Q;
+    }
+}
+
+// 7位格式：连续的7位小端位流，每8个元素7字节；len为4的倍数，末尾4个元素占4字节
+SCLOUDPLUS_KERNEL_INLINE void PackBits7(const uint16_t *in, const int len, uint8_t *out)
+{
+    int i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t temp = 0;
+        for (int j = 0; j < 8; j++) {
+            temp |= (uint64_t)(in[i + j] & 0x7F) << (7 * j);
         }
-        for (int i = 0; i < (inLen >> 3); i++) {
-            for (int j = 0; j < 8; j++) {
-                out[inLen + i] = (out[inLen + i] << 1) | ptrIn[16 * i + 2 * j + 1];
-            }
+        for (int j = 0; j < 7; j++) {
+            out[i / 8 * 7 + j] = (uint8_t)(temp >> (8 * j));
         }
-    } else if (para->ss == 24) {
-        const uint16_t *ptrIn = C;
-        uint8_t *ptrOut = out;
+    }
+    if (i < len) {
         uint32_t temp = 0;
-        for (int i = 0; i < para->mbar * para->n; i = i + 2) {
-            temp = U16ToU32(ptrIn);
-            temp = (temp & 0xFFF) ^ ((temp >> 4) & 0xFFF000);
-            *(uint32_t *)ptrOut = temp;
-            ptrIn = ptrIn + 2;
-            ptrOut = ptrOut + 3;
-        }
-    } else if (para->ss == 32) {
-        const int inLen = para->mbar * para->n;
-        const uint8_t *ptrIn = (uint8_t *)C;
-        for (int i = 0; i < inLen; i++) {
-            out[i] = ptrIn[2 * i];
+        for (int j = 0; j < 4; j++) {
+            temp |= (uint32_t)(in[i + j] & 0x7F) << (7 * j);
         }
-        for (int i = 0; i < (inLen >> 2); i++) {
-            for (int j = 0; j < 4; j++) {
-                out[inLen + i] = (out[inLen + i] << 2) | ptrIn[8 * i + 2 * j + 1];
-            }
+        for (int j = 0; j < 4; j++) {
+            out[i / 8 * 7 + j] = (uint8_t)(temp >> (8 * j));
         }
     }
 }
 
-void SCLOUDPLUS_UnPackC1(const uint8_t *in, const SCLOUDPLUS_Para *para, uint16_t *C)
+SCLOUDPLUS_KERNEL_INLINE void UnPackBits7(const uint8_t *in, const int len, const uint8_t shift, uint16_t *out)
 {
-    if (para->ss == 16) {
-        const int outLen = para->mbar * para->n;
-        for (int i = 0; i < outLen; i++) {
-            C[i] = (uint16_t)in[i];
-        }
-        for (int i = 0; i < (outLen >> 3); i++) {
-            C[8 * i] = C[8 * i] | (((uint16_t)in[outLen + i] << 1) & 0x100);
-            C[8 * i + 1] = C[8 * i + 1] | (((uint16_t)in[outLen + i] << 2) & 0x100);
-            C[8 * i + 2] = C[8 * i + 2] | (((uint16_t)in[outLen + i] << 3) & 0x100);
-            C[8 * i + 3] = C[8 * i + 3] | (((uint16_t)in[outLen + i] << 4) & 0x100);
-            C[8 * i + 4] = C[8 * i + 4] | (((uint16_t)in[outLen + i] << 5) & 0x100);
-            C[8 * i + 5] = C[8 * i + 5] | (((uint16_t)in[outLen + i] << 6) & 0x100);
-            C[8 * i + 6] = C[8 * i + 6] | (((uint16_t)in[outLen + i] << 7) & 0x100);
-            C[8 * i + 7] = C[8 * i + 7] | (((uint16_t)in[outLen + i] << 8) & 0x100);
-        }
-    } else if (para->ss == 24) {
-        const uint8_t *ptrIn = in;
-        uint16_t *ptrOut = C;
-        for (int i = 0; i < para->mbar * para->n; i = i + 2) {
-            *ptrOut = *(uint16_t *)ptrIn & SCLOUDPLUS_MOD_Q;
-            *(ptrOut + 1) = (*(uint16_t *)(ptrIn + 1) >> 4) & SCLOUDPLUS_MOD_Q;
-            ptrIn = ptrIn + 3;
-            ptrOut = ptrOut + 2;
+    int i = 0;
+    for (; i + 8 <= len; i += 8) {
+        const uint64_t temp = U8ToU56(in + i / 8 * 7);
+        for (int j = 0; j < 8; j++) {
+            out[i + j] = (uint16_t)(((temp >> (7 * j)) & 0x7F) << shift);
         }
-    } else if (para->ss == 32) {
-        const int outLen = para->mbar * para->n;
-        for (int i = 0; i < outLen; i++) {
-            C[i] = (uint16_t)in[i];
+    }
+    if (i < len) {
+        const uint32_t temp = U8ToU32(in + i / 8 * 7);
+        for (int j = 0; j < 4; j++) {
+            out[i + j] = (uint16_t)(((temp >> (7 * j)) & 0x7F) << shift);
         }
-        for (int i = 0; i < (outLen >> 2); i++) {
-            C[4 * i] = C[4 * i] | (((uint16_t)in[outLen + i] << 2) & 0x300);
-            C[4 * i + 1] = C[4 * i + 1] | (((uint16_t)in[outLen + i] << 4) & 0x300);
-            C[4 * i + 2] = C[4 * i + 2] | (((uint16_t)in[outLen + i] << 6) & 0x300);
-            C[4 * i + 3] = C[4 * i + 3] | (((uint16_t)in[outLen + i] << 8) & 0x300);
+    }
+}
+
+// 2位格式（私钥S）：每字节依次存放4个元素的低2位（首个元素在最低2位），解包时按2位有符号数扩展
+SCLOUDPLUS_KERNEL_INLINE void PackBits2(const uint16_t *in, const int len, uint8_t *out)
+{
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i weight = _mm_setr_epi16(1, 4, 16, 64, 1, 4, 16, 64);
+    const __m128i crumbMask = _mm_set1_epi16(0x03);
+    for (; i + 16 <= len; i += 16) {
+        const __m128i a = _mm_and_si128(_mm_loadu_si128((const __m128i *)(in + i)), crumbMask);
+        const __m128i b = _mm_and_si128(_mm_loadu_si128((const __m128i *)(in + i + 8)), crumbMask);
+        const uint32_t temp = PackCrumbs(a, b, weight);
+        memcpy(out + i / 4, &temp, sizeof(temp));
+    }
+#elif defined(__ARM_NEON)
+    static const int16_t bitPos[8] = {0, 2, 4, 6, 0, 2, 4, 6};
+    for (; i + 16 <= len; i += 16) {
+        const uint64x2_t a = PackLanes(vandq_u16(vld1q_u16(in + i), vdupq_n_u16(0x03)), bitPos);
+        const uint64x2_t b = PackLanes(vandq_u16(vld1q_u16(in + i + 8), vdupq_n_u16(0x03)), bitPos);
+        out[i / 4] = (uint8_t)vgetq_lane_u64(a, 0);
+        out[i / 4 + 1] = (uint8_t)vgetq_lane_u64(a, 1);
+        out[i / 4 + 2] = (uint8_t)vgetq_lane_u64(b, 0);
+        out[i / 4 + 3] = (uint8_t)vgetq_lane_u64(b, 1);
+    }
+#endif
+    for (; i < len; i += 4) {
+        out[i / 4] = (uint8_t)((in[i] & 0x03) | ((in[i + 1] & 0x03) << 2) | ((in[i + 2] & 0x03) << 4) |
+                               ((in[i + 3] & 0x03) << 6));
+    }
+}
+
+SCLOUDPLUS_KERNEL_INLINE void UnPackBits2(const uint8_t *in, const int len, uint16_t *out)
+{
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i weight = _mm_setr_epi16(1 << 14, 1 << 12, 1 << 10, 1 << 8, 1 << 14, 1 << 12, 1 << 10, 1 << 8);
+    for (; i + 16 <= len; i += 16) {
+        __m128i a;
+        __m128i b;
+        SpreadCrumbs(in + i / 4, &a, &b);
+        _mm_storeu_si128((__m128i *)(out + i), _mm_srai_epi16(_mm_mullo_epi16(a, weight), 14));
+        _mm_storeu_si128((__m128i *)(out + i + 8), _mm_srai_epi16(_mm_mullo_epi16(b, weight), 14));
+    }
+#elif defined(__ARM_NEON)
+    static const int16_t bitPos[8] = {14, 12, 10, 8, 14, 12, 10, 8};
+    const int16x8_t s = vld1q_s16(bitPos);
+    for (; i + 16 <= len; i += 16) {
+        const uint8_t *h = in + i / 4;
+        const int16x8_t a = vreinterpretq_s16_u16(vshlq_u16(SpreadByte2(h[0], h[1]), s));
+        const int16x8_t b = vreinterpretq_s16_u16(vshlq_u16(SpreadByte2(h[2], h[3]), s));
+        vst1q_u16(out + i, vreinterpretq_u16_s16(vshrq_n_s16(a, 14)));
+        vst1q_u16(out + i + 8, vreinterpretq_u16_s16(vshrq_n_s16(b, 14)));
+    }
+#endif
+    for (; i < len; i += 4) {
+        const uint8_t temp = in[i / 4];
+        for (int j = 0; j < 4; j++) {
+            out[i + j] = (uint16_t)((int16_t)(((temp >> (2 * j)) & 0x03) << 14) >> 14);
         }
     }
 }
 
-void SCLOUDPLUS_PackC2(const uint16_t *C, const SCLOUDPLUS_Para *para, uint8_t *out)
+SCLOUDPLUS_KERNEL_INLINE void KernelPackPK(const uint16_t *B, const SCLOUDPLUS_Para *para, uint8_t *pk)
+{
+    PackBits12(B, para->m * para->nbar, pk);
+}
+
+SCLOUDPLUS_KERNEL_INLINE void KernelUnPackPK(const uint8_t *pk, const SCLOUDPLUS_Para *para, uint16_t *B)
+{
+    UnPackBits12(pk, para->m * para->nbar, B);
+}
+
+SCLOUDPLUS_KERNEL_INLINE void KernelPackSK(const uint16_t *S, const SCLOUDPLUS_Para *para, uint8_t *sk)
+{
+    PackBits2(S, para->n * para->nbar, sk);
+}
+
+SCLOUDPLUS_KERNEL_INLINE void KernelUnPackSK(const uint8_t *sk, const SCLOUDPLUS_Para *para, uint16_t *S)
+{
+    UnPackBits2(sk, para->n * para->nbar, S);
+}
+
+/*
+ * C1压缩与打包在同一遍内完成（类似KYBER的四舍五入压缩）：
+ * ss为16时压缩为9位，32时压缩为10位，24时不压缩（12位）。
+ */
+SCLOUDPLUS_KERNEL_INLINE void KernelCompressPackC1(const uint16_t *C, const SCLOUDPLUS_Para *para, uint8_t *out)
 {
     if (para->ss == 16) {
-        const int inLen = para->mbar * para->nbar;
-        const uint16_t *ptrIn = C;
-        uint8_t *ptrOut = out;
-        for (int i = 0; i < inLen; i = i + 8) {
-            *ptrOut = ((*ptrIn) & 0x7F) | (*(ptrIn + 1) << 7);                  // 7+1
-            *(ptrOut + 1) = ((*(ptrIn + 1) >> 1) & 0x3F) | (*(ptrIn + 2) << 6); // 6+2
-            *(ptrOut + 2) = ((*(ptrIn + 2) >> 2) & 0x1F) | (*(ptrIn + 3) << 5); // 5+3
-            *(ptrOut + 3) = ((*(ptrIn + 3) >> 3) & 0x0F) | (*(ptrIn + 4) << 4); // 4+4
-            *(ptrOut + 4) = ((*(ptrIn + 4) >> 4) & 0x07) | (*(ptrIn + 5) << 3); // 3+5
-            *(ptrOut + 5) = ((*(ptrIn + 5) >> 5) & 0x03) | (*(ptrIn + 6) << 2); // 2+6
-            *(ptrOut + 6) = ((*(ptrIn + 6) >> 6) & 0x01) | (*(ptrIn + 7) << 1); // 1+7
-            ptrIn = ptrIn + 8;
-            ptrOut = ptrOut + 7;
-        }
+        PackBits9(C, para->mbar * para->n, 3, out);
     } else if (para->ss == 24) {
-        const int inLen = para->mbar * para->nbar;
-        const uint8_t *ptrIn = (uint8_t *)C;
-        for (int i = 0; i < inLen; i++) {
-            out[i] = ptrIn[2 * i];
-        }
-        for (int i = 0; i < (inLen >> 2); i++) {
-            for (int j = 0; j < 4; j++) {
-                out[inLen + i] = (out[inLen + i] << 2) | ptrIn[8 * i + 2 * j + 1];
-            }
-        }
+        PackBits12(C, para->mbar * para->n, out);
     } else if (para->ss == 32) {
-        const int inLen = para->mbar * para->nbar - ((para->mbar * para->nbar) & 0x7);
-
-        const uint16_t *ptrIn = C;
-        uint8_t *ptrOut = out;
-        for (int i = 0; i < inLen; i = i + 8) {
-            *ptrOut = ((*ptrIn) & 0x7F) | (*(ptrIn + 1) << 7);                  // 7+1
-            *(ptrOut + 1) = ((*(ptrIn + 1) >> 1) & 0x3F) | (*(ptrIn + 2) << 6); // 6+2
-            *(ptrOut + 2) = ((*(ptrIn + 2) >> 2) & 0x1F) | (*(ptrIn + 3) << 5); // 5+3
-            *(ptrOut + 3) = ((*(ptrIn + 3) >> 3) & 0x0F) | (*(ptrIn + 4) << 4); // 4+4
-            *(ptrOut + 4) = ((*(ptrIn + 4) >> 4) & 0x07) | (*(ptrIn + 5) << 3); // 3+5
-            *(ptrOut + 5) = ((*(ptrIn + 5) >> 5) & 0x03) | (*(ptrIn + 6) << 2); // 2+6
-            *(ptrOut + 6) = ((*(ptrIn + 6) >> 6) & 0x01) | (*(ptrIn + 7) << 1); // 1+7
-            ptrIn = ptrIn + 8;
-            ptrOut = ptrOut + 7;
-        }
-        *ptrOut = ((*ptrIn) & 0x7F) | (*(ptrIn + 1) << 7);
-        *(ptrOut + 1) = ((*(ptrIn + 1) >> 1) & 0x3F) | (*(ptrIn + 2) << 6);
-        *(ptrOut + 2) = ((*(ptrIn + 2) >> 2) & 0x1F) | (*(ptrIn + 3) << 5);
-        *(ptrOut + 3) = ((*(ptrIn + 3) >> 3) & 0x0F);
+        PackBits10(C, para->mbar * para->n, 2, out);
     }
 }
 
-void SCLOUDPLUS_UnPackC2(const uint8_t *in, const SCLOUDPLUS_Para *para, uint16_t *C)
+SCLOUDPLUS_KERNEL_INLINE void KernelUnPackDeCompressC1(const uint8_t *in, const SCLOUDPLUS_Para *para, uint16_t *C)
 {
     if (para->ss == 16) {
-        const uint8_t *ptrIn = in;
-        uint16_t *ptrOut = C;
-        const int outLen = para->mbar * para->nbar;
-        for (int i = 0; i < outLen; i = i + 8) {
-            *ptrOut = *ptrIn & 0x7F;
-            *(ptrOut + 1) = (*(uint16_t *)ptrIn >> 7) & 0x7F;
-            *(ptrOut + 2) = (*(uint16_t *)(ptrIn + 1) >> 6) & 0x7F;
-            *(ptrOut + 3) = (*(uint16_t *)(ptrIn + 2) >> 5) & 0x7F;
-            *(ptrOut + 4) = (*(uint16_t *)(ptrIn + 3) >> 4) & 0x7F;
-            *(ptrOut + 5) = (*(uint16_t *)(ptrIn + 4) >> 3) & 0x7F;
-            *(ptrOut + 6) = (*(uint16_t *)(ptrIn + 5) >> 2) & 0x7F;
-            *(ptrOut + 7) = (*(ptrIn + 6) >> 1) & 0x7F;
-            ptrIn = ptrIn + 7;
-            ptrOut = ptrOut + 8;
-        }
+        UnPackBits9(in, para->mbar * para->n, 3, C);
     } else if (para->ss == 24) {
-        const int outLen = para->mbar * para->nbar;
-        for (int i = 0; i < outLen; i++) {
-            C[i] = (uint16_t)in[i];
-        }
-        for (int i = 0; i < (outLen >> 2); i++) {
-            C[4 * i] = C[4 * i] | (((uint16_t)in[outLen + i] << 2) & 0x300);
-            C[4 * i + 1] = C[4 * i + 1] | (((uint16_t)in[outLen + i] << 4) & 0x300);
-            C[4 * i + 2] = C[4 * i + 2] | (((uint16_t)in[outLen + i] << 6) & 0x300);
-            C[4 * i + 3] = C[4 * i + 3] | (((uint16_t)in[outLen + i] << 8) & 0x300);
-        }
+        UnPackBits12(in, para->mbar * para->n, C);
     } else if (para->ss == 32) {
-        const int outLen = para->mbar * para->nbar - ((para->mbar * para->nbar) & 0x7);
-        const uint8_t *ptrIn = in;
-        uint16_t *ptrOut = C;
-        for (int i = 0; i < outLen; i = i + 8) {
-            *ptrOut = *ptrIn & 0x7F;
-            *(ptrOut + 1) = (*(uint16_t *)ptrIn >> 7) & 0x7F;
-            *(ptrOut + 2) = (*(uint16_t *)(ptrIn + 1) >> 6) & 0x7F;
-            *(ptrOut + 3) = (*(uint16_t *)(ptrIn + 2) >> 5) & 0x7F;
-            *(ptrOut + 4) = (*(uint16_t *)(ptrIn + 3) >> 4) & 0x7F;
-            *(ptrOut + 5) = (*(uint16_t *)(ptrIn + 4) >> 3) & 0x7F;
-            *(ptrOut + 6) = (*(uint16_t *)(ptrIn + 5) >> 2) & 0x7F;
-            *(ptrOut + 7) = (*(ptrIn + 6) >> 1) & 0x7F;
-            ptrIn = ptrIn + 7;
-            ptrOut = ptrOut + 8;
-        }
-        *ptrOut = *ptrIn & 0x7F;
-        *(ptrOut + 1) = (*(uint16_t *)ptrIn >> 7) & 0x7F;
-        *(ptrOut + 2) = (*(uint16_t *)(ptrIn + 1) >> 6) & 0x7F;
-        *(ptrOut + 3) = (*(uint16_t *)(ptrIn + 2) >> 5) & 0x7F;
+        UnPackBits10(in, para->mbar * para->n, 2, C);
+    }
+}
+
+//此函数对应论文算法5的C_2压缩时的四舍五入,针对0.5的情况要进行向奇数位的舍入,如0.5得到1, 3.5也是得到3.其他值仍为正常的四舍五入
+static inline uint16_t CompressC2(const uint16_t x, const uint8_t bits)
+{
+    const uint32_t temp = ((((uint32_t)(x & SCLOUDPLUS_MOD_Q) << bits) + 2048) >> 12);
+    const uint32_t remainder = (((uint32_t)(x & SCLOUDPLUS_MOD_Q) << bits) + 2048) % 6144;
+    return (uint16_t)((temp - ((!remainder) && 1)) & ((1u << bits) - 1));
+}
+
+// C2至多mbar * nbar（不超过SCLOUDPLUS_MAX_MBAR^2）个元素，先在栈上压缩再打包
+SCLOUDPLUS_KERNEL_INLINE void KernelCompressPackC2(const uint16_t *C, const SCLOUDPLUS_Para *para, uint8_t *out)
+{
+    const int len = para->mbar * para->nbar;
+    const uint8_t bits = (para->ss == 24) ? 10 : 7;
+    uint16_t c2[SCLOUDPLUS_MAX_MBAR * SCLOUDPLUS_MAX_MBAR];
+    for (int i = 0; i < len; i++) {
+        c2[i] = CompressC2(C[i], bits);
+    }
+    if (bits == 7) {
+        PackBits7(c2, len, out);
+    } else {
+        PackBits10(c2, len, 0, out);
     }
 }
 
-int8_t SCLOUDPLUS_Verify(const uint8_t *a, const uint8_t *b, const int Len)
+SCLOUDPLUS_KERNEL_INLINE void KernelUnPackDeCompressC2(const uint8_t *in, const SCLOUDPLUS_Para *para, uint16_t *C)
 {
-    uint8_t r = 0;
-    for (int i = 0; i < Len; i++) {
-        r |= a[i] ^ b[i];
+    if (para->ss == 16 || para->ss == 32) {
+        UnPackBits7(in, para->mbar * para->nbar, 5, C);
+    } else if (para->ss == 24) {
+        UnPackBits10(in, para->mbar * para->nbar, 2, C);
     }
+}
 
-    r = (-(int8_t)(r >> 1) | -(int8_t)(r & 1)) >> (8 * sizeof(uint8_t) - 1);
-    return (int8_t)r;
+static inline uint8_t BytesDiff(const uint8_t *a, const uint8_t *b, const int len)
+{
+    uint8_t diff = 0;
+    for (int i = 0; i < len; i++) {
+        diff |= a[i] ^ b[i];
+    }
+    return diff;
+}
+
+#define SCLOUDPLUS_CMP_BLOCK 256 // 逐块比较的元素数，16的倍数
+
+/*
+ * 按SCLOUDPLUS_CMP_BLOCK个元素一块压缩打包到栈上并与ct比较。对len个元素中从i开始的一块，
+ * 低字节区与高位区分别位于ct + i与ct + len + i / 8（9位）或ct + len + i / 4（10位）。
+ */
+SCLOUDPLUS_KERNEL_INLINE uint8_t KernelCompressCmpC1(const uint16_t *C, const SCLOUDPLUS_Para *para,
+    const uint8_t *ct)
+{
+    const int len = para->mbar * para->n;
+    uint8_t blk[SCLOUDPLUS_CMP_BLOCK / 2 * 3];
+    uint8_t diff = 0;
+    for (int i = 0; i < len; i += SCLOUDPLUS_CMP_BLOCK) {
+        const int num = (len - i < SCLOUDPLUS_CMP_BLOCK) ? (len - i) : SCLOUDPLUS_CMP_BLOCK;
+        if (para->ss == 16) {
+            PackBits9(C + i, num, 3, blk);
+            diff |= BytesDiff(blk, ct + i, num) | BytesDiff(blk + num, ct + len + i / 8, num / 8);
+        } else if (para->ss == 24) {
+            PackBits12(C + i, num, blk);
+            diff |= BytesDiff(blk, ct + i / 2 * 3, num / 2 * 3);
+        } else if (para->ss == 32) {
+            PackBits10(C + i, num, 2, blk);
+            diff |= BytesDiff(blk, ct + i, num) | BytesDiff(blk + num, ct + len + i / 4, num / 4);
+        }
+    }
+    return diff;
+}
+
+SCLOUDPLUS_KERNEL_INLINE uint8_t KernelCompressCmpC2(const uint16_t *C, const SCLOUDPLUS_Para *para,
+    const uint8_t *ct)
+{
+    uint8_t blk[SCLOUDPLUS_MAX_MBAR * SCLOUDPLUS_MAX_MBAR * 2];
+    KernelCompressPackC2(C, para, blk);
+    return BytesDiff(blk, ct, para->c2Size);
 }
 
 void SCLOUDPLUS_Add(const uint16_t *in0, const uint16_t *in1, const int len, uint16_t *out)
@@ -1152,294 +1402,588 @@ void SCLOUDPLUS_Sub(const uint16_t *in0, const uint16_t *in1, const int len, uin
     }
 }
 
-void SCLOUDPLUS_CS(const uint16_t *C, const uint16_t *S, const SCLOUDPLUS_Para *para, uint16_t *out)
+/**
+ * SCLOUDPLUS_TernaryCheck 函数（三元矩阵取值校验）
+ * 功能：检查rows×cols矩阵S的每行是否恰有h个+1、h个-1，其余元素为0；
+ *       按固定顺序读取全部元素，计数与取值无关地累加，不按S分支
+ * 返回：某行非零元个数不符或存在{0,1,-1}以外的取值时返回PQCP_SCLOUDPLUS_INVALID_ARG
+ */
+int32_t SCLOUDPLUS_TernaryCheck(const uint16_t *S, const uint16_t rows, const uint16_t cols, const uint16_t h)
 {
-    memset(out, 0, para->mbar * para->nbar * 2);
-    for (int i = 0; i < para->mbar; i++) {
-        for (int j = 0; j < para->nbar; j++) {
-            for (int k = 0; k < para->n; k++) {
-                out[i * para->nbar + j] += C[i * para->n + k] * (uint16_t)S[j * para->n + k];
+    uint32_t err = 0;
+    for (uint32_t i = 0; i < rows; i++) {
+        uint32_t posNum = 0;
+        uint32_t negNum = 0;
+        for (uint32_t k = 0; k < cols; k++) {
+            const uint16_t v = S[i * cols + k];
+            err |= (v != 0) & (v != 1) & (v != 0xFFFF);
+            posNum += (v == 1);
+            negNum += (v == 0xFFFF);
+        }
+        err |= (posNum != h) | (negNum != h);
+    }
+    return (err == 0) ? PQCP_SUCCESS : PQCP_SCLOUDPLUS_INVALID_ARG;
+}
+
+/**
+ * TransposeRows 函数（按8行一组转置）
+ * 功能：将rows行、每行cols个元素的矩阵in转置为out[k * stride + r] = in[r * cols + k]，
+ *       stride为rows向上取整到8的倍数，补齐的列置零，使每一列可按8元素向量整体读取
+ */
+SCLOUDPLUS_KERNEL_INLINE void TransposeRows(const uint16_t *in, const uint32_t rows, const uint32_t cols,
+    uint16_t *out)
+{
+    const uint32_t stride = (rows + SCLOUDPLUS_SIMD_LANES - 1) & ~(uint32_t)(SCLOUDPLUS_SIMD_LANES - 1);
+    for (uint32_t k = 0; k < cols; k++) {
+        uint32_t r = 0;
+        for (; r < rows; r++) {
+            out[k * stride + r] = in[r * cols + k];
+        }
+        for (; r < stride; r++) {
+            out[k * stride + r] = 0;
+        }
+    }
+}
+
+/**
+ * RowsMulAccumulate 函数（多行按系数累加）
+ * 功能：e[q] += Σ s[t] * rows[t * rowLen + q]，t ∈ [0, rowNum)，q ∈ [begin, end)；
+ *       按t顺序读取全部rowNum行，访存地址与次数与s无关；每段向量只读写e一次，累加过程保留在寄存器中
+ */
+SCLOUDPLUS_KERNEL_INLINE void RowsMulAccumulate(uint16_t *e, const uint16_t *rows, const uint32_t rowLen,
+    const uint16_t *s, const uint32_t rowNum, const uint32_t begin, const uint32_t end)
+{
+    uint32_t q = begin;
+#ifdef SCLOUDPLUS_SIMD_WIDE
+    for (; q + SCLOUDPLUS_SIMD_WIDE <= end; q += SCLOUDPLUS_SIMD_WIDE) {
+        SimdWideVec acc = SIMD_WIDE_LOAD(e + q);
+        for (uint32_t t = 0; t < rowNum; t++) {
+            acc = SIMD_WIDE_ADD(acc, SIMD_WIDE_MUL(SIMD_WIDE_LOAD(rows + t * rowLen + q), SIMD_WIDE_SET1(s[t])));
+        }
+        SIMD_WIDE_STORE(e + q, acc);
+    }
+#endif
+#ifdef SCLOUDPLUS_SIMD
+    for (; q + SCLOUDPLUS_SIMD_LANES <= end; q += SCLOUDPLUS_SIMD_LANES) {
+        SimdVec acc = SIMD_LOAD(e + q);
+        for (uint32_t t = 0; t < rowNum; t++) {
+            acc = SIMD_ADD(acc, SIMD_MUL(SIMD_LOAD(rows + t * rowLen + q), SIMD_SET1(s[t])));
+        }
+        SIMD_STORE(e + q, acc);
+    }
+#endif
+    for (; q < end; q++) {
+        uint16_t acc = e[q];
+        for (uint32_t t = 0; t < rowNum; t++) {
+            acc += (uint16_t)((uint32_t)rows[t * rowLen + q] * s[t]);
+        }
+        e[q] = acc;
+    }
+}
+
+#define SCLOUDPLUS_CS_STRIDE(para) (((para)->mbar + SCLOUDPLUS_SIMD_LANES - 1) & ~(uint32_t)(SCLOUDPLUS_SIMD_LANES - 1))
+
+/**
+ * MulColumns 函数（转置矩阵的列按系数累加）
+ * 功能：sum[0..stride) = Σ s[k] * aT[k]，k ∈ [0, cols)，aT由TransposeRows生成，stride为8的倍数；
+ *       按k顺序读取全部列，访存地址与s无关
+ */
+SCLOUDPLUS_KERNEL_INLINE void MulColumns(const uint16_t *aT, const uint32_t stride, const uint16_t *s,
+    const uint32_t cols, uint16_t *sum)
+{
+    for (uint32_t g = 0; g < stride; g += SCLOUDPLUS_SIMD_LANES) {
+#ifdef SCLOUDPLUS_SIMD
+        SimdVec acc = SIMD_ZERO();
+        for (uint32_t k = 0; k < cols; k++) {
+            acc = SIMD_ADD(acc, SIMD_MUL(SIMD_LOAD(aT + k * stride + g), SIMD_SET1(s[k])));
+        }
+        SIMD_STORE(sum + g, acc);
+#else
+        uint16_t acc[SCLOUDPLUS_SIMD_LANES] = {0};
+        for (uint32_t k = 0; k < cols; k++) {
+            const uint16_t *p = aT + k * stride + g;
+            for (uint32_t r = 0; r < SCLOUDPLUS_SIMD_LANES; r++) {
+                acc[r] += (uint16_t)((uint32_t)p[r] * s[k]);
             }
         }
+        memcpy(sum + g, acc, sizeof(acc));
+#endif
+    }
+}
+
+/*
+ * out = C * S^T，S为解包后的nbar * n长期私钥；C转置后逐列乘以S的系数累加，转置结果存于tmp，
+ * 读取C的顺序与S无关
+ */
+SCLOUDPLUS_KERNEL_INLINE void KernelCS(const uint16_t *C, const uint16_t *S, const SCLOUDPLUS_Para *para,
+    uint16_t *out, uint16_t *tmp)
+{
+    const uint32_t stride = SCLOUDPLUS_CS_STRIDE(para);
+    uint16_t *CT = tmp;
+    uint16_t sum[SCLOUDPLUS_SIMD_LANES * 2]; // mbar不超过16
+    TransposeRows(C, para->mbar, para->n, CT);
+    for (int j = 0; j < para->nbar; j++) {
+        MulColumns(CT, stride, S + j * para->n, para->n, sum);
+        for (int i = 0; i < para->mbar; i++) {
+            out[i * para->nbar + j] = sum[i];
+        }
     }
 }
 
-void SCLOUDPLUS_SB_E(const uint16_t *S, const uint16_t *B, const uint16_t *E, const SCLOUDPLUS_Para *para, uint16_t *out)
+// out = S1 * B + E，S1为mbar * m的三元矩阵；按k顺序读取B的全部行乘以S1的系数累加，访存与S1无关
+SCLOUDPLUS_KERNEL_INLINE void KernelSB_E(const uint16_t *S, const uint16_t *B, const uint16_t *E,
+    const SCLOUDPLUS_Para *para, uint16_t *out)
 {
     memcpy(out, E, para->mbar * para->nbar * 2);
     for (int i = 0; i < para->mbar; i++) {
-        for (int j = 0; j < para->nbar; j++) {
+        const uint16_t *s = S + i * para->m;
+        uint16_t *o = out + i * para->nbar;
+#ifdef SCLOUDPLUS_SIMD
+        if (para->nbar >= SCLOUDPLUS_SIMD_LANES) {
+            // nbar不是8的倍数时，尾部向量与首向量部分重叠，重叠元素两次计算结果相同
+            const uint32_t tail = para->nbar - SCLOUDPLUS_SIMD_LANES;
+            SimdVec acc0 = SIMD_LOAD(o);
+            SimdVec acc1 = SIMD_LOAD(o + tail);
             for (int k = 0; k < para->m; k++) {
-                out[i * para->nbar + j] += (uint16_t)S[i * para->m + k] * B[k * para->nbar + j];
+                const uint16_t *b = B + k * para->nbar;
+                const SimdVec c = SIMD_SET1(s[k]);
+                acc0 = SIMD_ADD(acc0, SIMD_MUL(SIMD_LOAD(b), c));
+                acc1 = SIMD_ADD(acc1, SIMD_MUL(SIMD_LOAD(b + tail), c));
+            }
+            SIMD_STORE(o + tail, acc1);
+            SIMD_STORE(o, acc0);
+            continue;
+        }
+#endif
+        for (int k = 0; k < para->m; k++) {
+            const uint16_t *b = B + k * para->nbar;
+            for (int j = 0; j < para->nbar; j++) {
+                o[j] += (uint16_t)((uint32_t)b[j] * s[k]);
             }
         }
     }
 }
 
-int32_t SCLOUDPLUS_AS_E(const uint8_t *seedA, const uint16_t *S, const uint16_t *E, const SCLOUDPLUS_Para *para,
-                        uint16_t *B)
+/*
+ * 矩阵A行生成器：支持AES指令时直接调用轮指令（见scloudplus_aes.c），计数器在寄存器中构造；
+ * 否则经EAL以AES-128-ECB加密计数器缓冲区。
+ */
+typedef struct {
+#ifdef SCLOUDPLUS_AES_NATIVE
+    SCLOUDPLUS_AesKey key;
+#else
+    CRYPT_EAL_CipherCtx *cipherCtx;
+    uint32_t *aRowIn; // 8行计数器，仅每个分组首字写入计数器，其余保持为0
+#endif
+    uint16_t *aRow;   // 当前展开的8行块，可驻留L1
+} MatrixAGen;
+
+#ifdef SCLOUDPLUS_AES_NATIVE
+#define MATRIX_A_GEN_LEN(para) (SCLOUDPLUS_SA_E_ROWS * (uint32_t)(para)->n)
+#else
+#define MATRIX_A_GEN_LEN(para) (2 * SCLOUDPLUS_SA_E_ROWS * (uint32_t)(para)->n)
+#endif
+
+// tmp至少MATRIX_A_GEN_LEN个uint16_t，由调用者提供
+static int32_t MatrixAGenInit(MatrixAGen *gen, const uint8_t *seedA, const SCLOUDPLUS_Para *para, uint16_t *tmp)
 {
-    int32_t ret = 0;
-    memcpy(B, E, para->m * para->nbar * 2);
-    CRYPT_EAL_CipherCtx *RandCtx = CRYPT_EAL_CipherNewCtx(CRYPT_CIPHER_AES128_ECB);
-    if (RandCtx == NULL) {
+    gen->aRow = tmp;
+#ifdef SCLOUDPLUS_AES_NATIVE
+    (void)para;
+    SCLOUDPLUS_AesKeyInit(seedA, &gen->key);
+    return PQCP_SUCCESS;
+#else
+    gen->aRowIn = (uint32_t *)(tmp + SCLOUDPLUS_SA_E_ROWS * para->n);
+    memset(gen->aRowIn, 0, SCLOUDPLUS_SA_E_ROWS * para->n * sizeof(uint16_t));
+    gen->cipherCtx = CRYPT_EAL_CipherNewCtx(CRYPT_CIPHER_AES128_ECB);
+    if (gen->cipherCtx == NULL) {
         return PQCP_MEM_ALLOC_FAIL;
     }
-    uint32_t outLen = 4 * para->n * sizeof(uint16_t);
+    int32_t ret = CRYPT_EAL_CipherInit(gen->cipherCtx, seedA, 16, NULL, 0, true);
+    if (ret != PQCP_SUCCESS) {
+        CRYPT_EAL_CipherFreeCtx(gen->cipherCtx);
+        gen->cipherCtx = NULL;
+        return ret;
+    }
+    ret = CRYPT_EAL_CipherSetPadding(gen->cipherCtx, CRYPT_PADDING_NONE);
+    if (ret != PQCP_SUCCESS) {
+        CRYPT_EAL_CipherFreeCtx(gen->cipherCtx);
+        gen->cipherCtx = NULL;
+        return ret;
+    }
+    return PQCP_SUCCESS;
+#endif
+}
+
+static void MatrixAGenDeinit(MatrixAGen *gen)
+{
+#ifdef SCLOUDPLUS_AES_NATIVE
+    (void)gen;
+#else
+    CRYPT_EAL_CipherFreeCtx(gen->cipherCtx);
+    gen->cipherCtx = NULL;
+#endif
+}
+
+/**
+ * MatrixAGenRows 函数（矩阵A行展开）
+ * 功能：以AES-128-ECB加密计数器，生成矩阵A从第row行开始的rowNum行（rowNum不超过8），按行存放于aRowOut
+ */
+static int32_t MatrixAGenRows(MatrixAGen *gen, const SCLOUDPLUS_Para *para, const uint32_t row,
+                              const uint32_t rowNum, uint16_t *aRowOut)
+{
+#ifdef SCLOUDPLUS_AES_NATIVE
+    SCLOUDPLUS_AesGenRows(&gen->key, para, row, rowNum, aRowOut);
+    return PQCP_SUCCESS;
+#else
     const int blockRowLen = para->h1 * 2;
     const int blockNumber = para->h1 >> 1;
-    uint32_t aRowIn[4 * blockRowLen];
-    uint16_t aRowOut[4 * para->n];
-    memset(aRowIn, 0, 4 * blockRowLen * sizeof(uint32_t));
-    ret = CRYPT_EAL_CipherInit(RandCtx, seedA, 16, NULL, 0, true);
-    if (ret != PQCP_SUCCESS) {
-        goto EXIT;
+    uint32_t outLen = rowNum * para->n * sizeof(uint16_t);
+    for (uint32_t q = 0; q < rowNum; q++) {
+        for (int p = 0; p < blockNumber; p++) {
+            gen->aRowIn[q * blockRowLen + 4 * p] = (row + q) * blockNumber + p;
+        }
     }
-    ret = CRYPT_EAL_CipherSetPadding(RandCtx, CRYPT_PADDING_NONE);
+    return CRYPT_EAL_CipherUpdate(gen->cipherCtx, (uint8_t *)gen->aRowIn, rowNum * para->n * sizeof(uint16_t),
+                                  (uint8_t *)aRowOut, &outLen);
+#endif
+}
+
+// 生成矩阵A从第row行开始的8行并转置为aRowT[k * 8 + r]
+static int32_t MatrixAGenRowsT(MatrixAGen *gen, const SCLOUDPLUS_Para *para, const uint32_t row, uint16_t *aRowT)
+{
+#ifdef SCLOUDPLUS_AES_NATIVE
+    SCLOUDPLUS_AesGenRowsT(&gen->key, para, row, aRowT);
+    return PQCP_SUCCESS;
+#else
+    int32_t ret = MatrixAGenRows(gen, para, row, SCLOUDPLUS_SA_E_ROWS, gen->aRow);
     if (ret != PQCP_SUCCESS) {
-        goto EXIT;
+        return ret;
     }
+    TransposeRows(gen->aRow, SCLOUDPLUS_SA_E_ROWS, para->n, aRowT);
+    return PQCP_SUCCESS;
+#endif
+}
 
-    for (int i = 0; i < para->m; i = i + 4) {
-        for (int j = 0; j < blockNumber; j++) {
-            aRowIn[4 * j + 0 * blockRowLen] = i * blockNumber + j;
-            aRowIn[4 * j + 1 * blockRowLen] = (i + 1) * blockNumber + j;
-            aRowIn[4 * j + 2 * blockRowLen] = (i + 2) * blockNumber + j;
-            aRowIn[4 * j + 3 * blockRowLen] = (i + 3) * blockNumber + j;
+int32_t SCLOUDPLUS_ExpandA(const uint8_t *seedA, const SCLOUDPLUS_Para *para, const uint32_t rowNum, uint16_t *A,
+                           uint16_t *tmp)
+{
+    MatrixAGen gen;
+    int32_t ret = MatrixAGenInit(&gen, seedA, para, tmp);
+    if (ret != PQCP_SUCCESS) {
+        return ret;
+    }
+    for (uint32_t i = 0; i < rowNum; i += SCLOUDPLUS_SA_E_ROWS) {
+        uint32_t num = (rowNum - i < SCLOUDPLUS_SA_E_ROWS) ? (rowNum - i) : SCLOUDPLUS_SA_E_ROWS;
+        ret = MatrixAGenRows(&gen, para, i, num, A + i * para->n);
+        if (ret != PQCP_SUCCESS) {
+            break;
         }
-        ret = CRYPT_EAL_CipherUpdate(RandCtx, (uint8_t *)aRowIn, 4 * para->n * sizeof(uint16_t), (uint8_t *)aRowOut,
-                                     &outLen);
+    }
+    MatrixAGenDeinit(&gen);
+    return ret;
+}
+
+/*
+ * 计算B += A * S^T中矩阵A第[rowBegin, rowEnd)行的部分，S为nbar * n的三元矩阵。
+ * 每次展开8行A并转置，使同一列的8个元素连续，逐列乘以S的系数累加，读取顺序与S无关
+ */
+SCLOUDPLUS_KERNEL_INLINE int32_t KernelAS_E_Rows(const uint8_t *seedA, const uint16_t *S,
+    const SCLOUDPLUS_Para *para, const uint32_t rowBegin, const uint32_t rowEnd, uint16_t *B, uint16_t *tmp)
+{
+    int32_t ret = 0;
+    uint16_t *aRowT = tmp;
+    uint16_t sum[SCLOUDPLUS_SA_E_ROWS];
+    MatrixAGen gen;
+    ret = MatrixAGenInit(&gen, seedA, para, tmp + SCLOUDPLUS_SA_E_ROWS * para->n);
+    if (ret != PQCP_SUCCESS) {
+        return ret;
+    }
+
+    for (uint32_t i = rowBegin; i < rowEnd; i += SCLOUDPLUS_SA_E_ROWS) {
+        ret = MatrixAGenRowsT(&gen, para, i, aRowT);
         if (ret != PQCP_SUCCESS) {
             goto EXIT;
         }
         for (int k = 0; k < para->nbar; k++) {
-            uint16_t sum[4] = {0};
-            for (int j = 0; j < para->n; j++) {
-                const uint16_t sp = S[k * para->n + j];
-                sum[0] += aRowOut[0 * para->n + j] * sp;
-                sum[1] += aRowOut[1 * para->n + j] * sp;
-                sum[2] += aRowOut[2 * para->n + j] * sp;
-                sum[3] += aRowOut[3 * para->n + j] * sp;
+            MulColumns(aRowT, SCLOUDPLUS_SA_E_ROWS, S + k * para->n, para->n, sum);
+            for (int r = 0; r < SCLOUDPLUS_SA_E_ROWS; r++) {
+                B[(i + r) * para->nbar + k] += sum[r];
             }
-            B[(i + 0) * para->nbar + k] += sum[0];
-            B[(i + 1) * para->nbar + k] += sum[1];
-            B[(i + 2) * para->nbar + k] += sum[2];
-            B[(i + 3) * para->nbar + k] += sum[3];
         }
     }
 
 EXIT:
-    CRYPT_EAL_CipherFreeCtx(RandCtx);
+    MatrixAGenDeinit(&gen);
     return ret;
 }
 
-int32_t SCLOUDPLUS_SA_E(const uint8_t *seedA, const uint16_t *S, uint16_t *E, const SCLOUDPLUS_Para *para, uint16_t *C)
-{
-    int32_t ret = 0;
-    uint32_t outLen = 8 * para->n * sizeof(uint16_t);
-    const int blockRowLen = para->h1 * 2;
-    const int blockNumber = para->h1 >> 1;
-    uint32_t aRowIn[8 * blockRowLen];
-    uint16_t aRowOut[8 * para->n];
-    memset(aRowIn, 0, 8 * blockRowLen * sizeof(uint32_t));
+#ifdef SCLOUDPLUS_SIMD_WIDE
+#define SA_E_STRIPE_VECS (SCLOUDPLUS_SA_E_TILE_COLS / SCLOUDPLUS_SIMD_WIDE)
+#else
+#define SA_E_STRIPE_VECS (SCLOUDPLUS_SA_E_TILE_COLS / SCLOUDPLUS_SIMD_LANES)
+#endif
 
-    CRYPT_EAL_CipherCtx *RandCtx = CRYPT_EAL_CipherNewCtx(CRYPT_CIPHER_AES128_ECB);
-    if (RandCtx == NULL) {
-        return PQCP_MEM_ALLOC_FAIL;
+/**
+ * StripeMulAccumulate 函数（整列条按系数累加）
+ * 功能：e[q] += Σ s[t] * rows[t * rowLen + q]，t ∈ [0, rowNum)，q ∈ [0, SCLOUDPLUS_SA_E_TILE_COLS)；
+ *       整个列条的累加值驻留寄存器，每行只广播一次系数，循环次数与访存地址与s无关
+ */
+SCLOUDPLUS_KERNEL_INLINE void StripeMulAccumulate(uint16_t *e, const uint16_t *rows, const uint32_t rowLen,
+    const uint16_t *s, const uint32_t rowNum)
+{
+#if defined(SCLOUDPLUS_SIMD_WIDE)
+    SimdWideVec acc[SA_E_STRIPE_VECS];
+    for (uint32_t v = 0; v < SA_E_STRIPE_VECS; v++) {
+        acc[v] = SIMD_WIDE_LOAD(e + v * SCLOUDPLUS_SIMD_WIDE);
     }
-    ret = CRYPT_EAL_CipherInit(RandCtx, seedA, 16, NULL, 0, true);
-    if (ret != PQCP_SUCCESS) {
-        goto EXIT;
+    for (uint32_t t = 0; t < rowNum; t++) {
+        const SimdWideVec c = SIMD_WIDE_SET1(s[t]);
+        const uint16_t *r = rows + t * rowLen;
+        for (uint32_t v = 0; v < SA_E_STRIPE_VECS; v++) {
+            acc[v] = SIMD_WIDE_ADD(acc[v], SIMD_WIDE_MUL(SIMD_WIDE_LOAD(r + v * SCLOUDPLUS_SIMD_WIDE), c));
+        }
     }
-    ret = CRYPT_EAL_CipherSetPadding(RandCtx, CRYPT_PADDING_NONE);
-    if (ret != PQCP_SUCCESS) {
-        goto EXIT;
+    for (uint32_t v = 0; v < SA_E_STRIPE_VECS; v++) {
+        SIMD_WIDE_STORE(e + v * SCLOUDPLUS_SIMD_WIDE, acc[v]);
+    }
+#elif defined(SCLOUDPLUS_SIMD)
+    SimdVec acc[SA_E_STRIPE_VECS];
+    for (uint32_t v = 0; v < SA_E_STRIPE_VECS; v++) {
+        acc[v] = SIMD_LOAD(e + v * SCLOUDPLUS_SIMD_LANES);
+    }
+    for (uint32_t t = 0; t < rowNum; t++) {
+        const SimdVec c = SIMD_SET1(s[t]);
+        const uint16_t *r = rows + t * rowLen;
+        for (uint32_t v = 0; v < SA_E_STRIPE_VECS; v++) {
+            acc[v] = SIMD_ADD(acc[v], SIMD_MUL(SIMD_LOAD(r + v * SCLOUDPLUS_SIMD_LANES), c));
+        }
+    }
+    for (uint32_t v = 0; v < SA_E_STRIPE_VECS; v++) {
+        SIMD_STORE(e + v * SCLOUDPLUS_SIMD_LANES, acc[v]);
     }
+#else
+    RowsMulAccumulate(e, rows, rowLen, s, rowNum, 0, SCLOUDPLUS_SA_E_TILE_COLS);
+#endif
+}
 
-    for (int i = 0; i < para->m; i += 8) {
-        for (int q = 0; q < 8; q++) {
-            for (int p = 0; p < blockNumber; p += 1) {
-                aRowIn[q * blockRowLen + 4 * p] = (i + q) * blockNumber + p;
-            }
+/*
+ * 将矩阵A的行块rows（tileRows行）乘以S在该行块上的系数（第j行系数为s[j * m + t]）累加到E的各行。
+ * 按SCLOUDPLUS_SA_E_TILE_COLS列分条：E每一行的列条驻留寄存器，依次乘加行块的全部tileRows行，
+ * 所读取的行块列条（不超过SCLOUDPLUS_SA_E_TILE_ROWS * SCLOUDPLUS_SA_E_TILE_COLS个元素）驻留L1；
+ * 每个行块的循环次数只取决于n、mbar与tileRows，不随S变化
+ */
+SCLOUDPLUS_KERNEL_INLINE void SA_E_Tile(uint16_t *E, const SCLOUDPLUS_Para *para, const uint16_t *s,
+    const uint16_t *rows, const uint32_t tileRows)
+{
+    uint32_t q = 0;
+    for (; q + SCLOUDPLUS_SA_E_TILE_COLS <= para->n; q += SCLOUDPLUS_SA_E_TILE_COLS) {
+        for (int j = 0; j < para->mbar; j++) {
+            StripeMulAccumulate(E + j * para->n + q, rows + q, para->n, s + j * para->m, tileRows);
         }
-        ret = CRYPT_EAL_CipherUpdate(RandCtx, (uint8_t *)aRowIn, 8 * para->n * sizeof(uint16_t), (uint8_t *)aRowOut,
-                                     &outLen);
+    }
+    for (int j = 0; j < para->mbar && q < para->n; j++) {
+        RowsMulAccumulate(E + j * para->n, rows, para->n, s + j * para->m, tileRows, q, para->n);
+    }
+}
+
+/**
+ * KernelSA_E_Rows 函数（计算 E += S * A 中矩阵A第[rowBegin, rowEnd)行的部分）
+ * 功能：每次展开矩阵A的SCLOUDPLUS_SA_E_TILE_ROWS行作为行块，按列条累加到E上，
+ *       E在每个行块只读写一次；num组S/E共用同一次展开，矩阵A每批只遍历一次
+ * 参数：
+ *   - cacheA/cacheRows：已展开的矩阵A前cacheRows行（cacheRows为8的倍数），
+ *     这部分行直接读取缓存，其余行仍由seedA即时展开；cacheA可为NULL
+ *   - S：mbar * m的三元矩阵，行块内的每一行都乘以S的对应系数累加，循环次数与访存地址只取决于参数集
+ */
+SCLOUDPLUS_KERNEL_INLINE int32_t KernelSA_E_Rows(const uint8_t *seedA, const uint16_t *cacheA,
+    const uint32_t cacheRows, const uint32_t num, const uint16_t *S, uint16_t *E, const SCLOUDPLUS_Para *para,
+    const uint32_t rowBegin, const uint32_t rowEnd, uint16_t *tmp)
+{
+    if (num == 0 || num > SCLOUDPLUS_ENCAPS_BATCH_MAX) {
+        return PQCP_SCLOUDPLUS_INVALID_ARG;
+    }
+    int32_t ret = PQCP_SUCCESS;
+    const uint32_t sLen = para->mbar * para->m;
+    const uint32_t matLen = para->mbar * para->n;
+    uint16_t *tile = tmp;
+    const uint32_t cachedRows = (cacheA == NULL) ? 0 : cacheRows;
+
+    MatrixAGen gen;
+    if (cachedRows < rowEnd) {
+        ret = MatrixAGenInit(&gen, seedA, para, tmp + SCLOUDPLUS_SA_E_TILE_ROWS * para->n);
         if (ret != PQCP_SUCCESS) {
-            goto EXIT;
+            return ret;
         }
+    }
 
-        for (int j = 0; j < para->mbar; j++) {
-            uint16_t sum = 0;
-            uint16_t sp[8];
-            for (int p = 0; p < 8; p++) {
-                sp[p] = S[j * para->m + i + p];
-            }
-            for (int q = 0; q < para->n; q++) {
-                sum = E[j * para->n + q];
-                for (int p = 0; p < 8; p++) {
-                    sum += sp[p] * aRowOut[p * para->n + q];
+    for (uint32_t i = rowBegin; i < rowEnd;) {
+        // 行块不跨越缓存边界：缓存内的行块直接读取缓存，其余按8行一组展开到tile
+        const uint32_t limit = (i < cachedRows && cachedRows < rowEnd) ? cachedRows : rowEnd;
+        const uint32_t tileRows = (limit - i < SCLOUDPLUS_SA_E_TILE_ROWS) ? (limit - i) : SCLOUDPLUS_SA_E_TILE_ROWS;
+        const uint16_t *rows = tile;
+        if (i < cachedRows) {
+            rows = cacheA + i * para->n;
+        } else {
+            for (uint32_t r = 0; r < tileRows; r += SCLOUDPLUS_SA_E_ROWS) {
+                ret = MatrixAGenRows(&gen, para, i + r, SCLOUDPLUS_SA_E_ROWS, tile + r * para->n);
+                if (ret != PQCP_SUCCESS) {
+                    goto EXIT;
                 }
-                E[j * para->n + q] = sum;
             }
         }
+        for (uint32_t b = 0; b < num; b++) {
+            SA_E_Tile(E + b * matLen, para, S + b * sLen + i, rows, tileRows);
+        }
+        i += tileRows;
     }
-    memcpy((unsigned char *)C, (unsigned char *)E, 2 * para->mbar * para->n);
 
 EXIT:
-    CRYPT_EAL_CipherFreeCtx(RandCtx);
+    if (cachedRows < rowEnd) {
+        MatrixAGenDeinit(&gen);
+    }
     return ret;
 }
 
-static inline void CBD1(const uint8_t in, uint16_t *out)
+/*
+ * 中心二项分布采样（CBD）：每组eta字节（8 * eta位）生成4个系数，
+ * 第i个系数为第2i个与第2i+1个eta位段的汉明重量之差；eta为1、2、3、7时与逐字节实现结果一致。
+ * 按位并行计算，不查表、不分支，与输入无关地恒定耗时。
+ */
+static inline void CBDGroup(const uint64_t in, const uint32_t eta, uint16_t *out)
 {
-    uint8_t b = 0, b0 = 0, b1 = 0;
-    b = in;
-    for (size_t j = 0; j < 4; j++) {
-        b0 = b & 1;
-        b1 = (b >> 1) & 1;
-        *(out + j) = (uint16_t)(b0 - b1);
-        b = b >> 2;
+    uint64_t lsb = 0; // 每个eta位段的最低位
+    for (uint32_t k = 0; k < 8; k++) {
+        lsb |= (uint64_t)1 << (k * eta);
+    }
+    uint64_t b = 0;
+    for (uint32_t k = 0; k < eta; k++) {
+        b += (in >> k) & lsb;
+    }
+    const uint64_t fieldMask = ((uint64_t)1 << eta) - 1;
+    for (uint32_t i = 0; i < 4; i++) {
+        out[i] = (uint16_t)(((b >> (2 * i * eta)) & fieldMask) - ((b >> ((2 * i + 1) * eta)) & fieldMask));
     }
 }
 
-static inline void CBD2(const uint8_t in, uint16_t *out)
+// 以小端序读取eta字节
+static inline uint64_t CBDLoad(const uint8_t *in, const uint32_t eta)
 {
-    uint8_t b = 0;
-    b += in & 0x55;
-    b += (in >> 1) & 0x55;
-    *out = (uint16_t)((b & 0x03) - ((b >> 2) & 0x03));
-    *(out + 1) = (uint16_t)(((b >> 4) & 0x03) - ((b >> 6) & 0x03));
+    uint64_t v = 0;
+    for (uint32_t k = 0; k < eta; k++) {
+        v |= (uint64_t)in[k] << (8 * k);
+    }
+    return v;
 }
 
-static inline void cbd3(const uint32_t in, uint16_t *out)
+// eta为常量时展开，编译器可按组向量化
+#define CBD_GROUPS(in, eta, groups, out)                                        \
+    do {                                                                        \
+        for (uint32_t g_ = 0; g_ < (groups); g_++) {                            \
+            CBDGroup(CBDLoad((in) + g_ * (eta), (eta)), (eta), (out) + 4 * g_); \
+        }                                                                       \
+    } while (0)
+
+#define SCLOUDPLUS_SHAKE256_RATE 136
+#define SCLOUDPLUS_CBD_ETA_MAX 7
+
+/*
+ * SHAKE256输出流：每次挤出rate * eta字节，缓冲区可驻留L1，且整组（eta字节）不会跨越两次挤出，
+ * 连续采样多个矩阵时输出与一次挤出全部哈希值相同
+ */
+typedef struct {
+    CRYPT_EAL_MdCtx *mdCtx;
+    uint32_t eta;
+    uint32_t pos;
+    uint32_t len;
+    uint8_t buf[SCLOUDPLUS_SHAKE256_RATE * SCLOUDPLUS_CBD_ETA_MAX];
+} CBDStream;
+
+static int32_t CBDStreamInit(CBDStream *st, CRYPT_EAL_MdCtx *mdCtx, const uint8_t *seed, const uint8_t eta)
 {
-    uint32_t b = 0;
-    b += in & 0x00249249;
-    b += (in >> 1) & 0x00249249;
-    b += (in >> 2) & 0x00249249;
-    for (int i = 0; i < 4; i++) {
-        out[i] = ((b >> (6 * i)) & 0x07) - ((b >> (6 * i + 3)) & 0x07);
+    if (eta != 1 && eta != 2 && eta != 3 && eta != 7) {
+        return PQCP_SCLOUDPLUS_INVALID_ARG;
     }
+    st->mdCtx = mdCtx;
+    st->eta = eta;
+    st->pos = 0;
+    st->len = 0;
+    int32_t ret = CRYPT_EAL_MdInit(mdCtx);
+    if (ret != PQCP_SUCCESS) {
+        return ret;
+    }
+    return CRYPT_EAL_MdUpdate(mdCtx, seed, SCLOUDPLUS_SEED_R2_LEN);
 }
 
-static inline void CBD7(const uint64_t in, uint16_t *out)
+// 采样num（4的倍数）个系数
+static int32_t CBDStreamSample(CBDStream *st, uint16_t *out, uint32_t num)
 {
-    uint64_t b0 = 0;
-    b0 += in & 0x2040810204081;
-    b0 += (in >> 1) & 0x2040810204081;
-    b0 += (in >> 2) & 0x2040810204081;
-    b0 += (in >> 3) & 0x2040810204081;
-    b0 += (in >> 4) & 0x2040810204081;
-    b0 += (in >> 5) & 0x2040810204081;
-    b0 += (in >> 6) & 0x2040810204081;
-    for (int i = 0; i < 4; i++) {
-        out[i] = ((b0 >> (14 * i)) & 0x7F) - ((b0 >> (14 * i + 7)) & 0x7F);
+    const uint32_t eta = st->eta;
+    if ((num & 3) != 0) {
+        return PQCP_SCLOUDPLUS_INVALID_ARG;
+    }
+    while (num > 0) {
+        if (st->pos == st->len) {
+            int32_t ret = CRYPT_EAL_MdSqueeze(st->mdCtx, st->buf, SCLOUDPLUS_SHAKE256_RATE * eta);
+            if (ret != PQCP_SUCCESS) {
+                return ret;
+            }
+            st->pos = 0;
+            st->len = SCLOUDPLUS_SHAKE256_RATE * eta;
+        }
+        uint32_t groups = (st->len - st->pos) / eta;
+        groups = (groups > (num >> 2)) ? (num >> 2) : groups;
+        const uint8_t *in = st->buf + st->pos;
+        switch (eta) {
+            case 1:
+                CBD_GROUPS(in, 1, groups, out);
+                break;
+            case 2:
+                CBD_GROUPS(in, 2, groups, out);
+                break;
+            case 3:
+                CBD_GROUPS(in, 3, groups, out);
+                break;
+            default:
+                CBD_GROUPS(in, 7, groups, out);
+                break;
+        }
+        st->pos += groups * eta;
+        out += 4 * groups;
+        num -= 4 * groups;
     }
+    return PQCP_SUCCESS;
 }
 
-int32_t SCLOUDPLUS_SampleEta1(const uint8_t *seed, const SCLOUDPLUS_Para *para, uint16_t *matrixE)
+int32_t SCLOUDPLUS_SampleEta1(const uint8_t *seed, const SCLOUDPLUS_Para *para, CRYPT_EAL_MdCtx *mdCtx,
+                              uint16_t *matrixE)
 {
-    memset(matrixE, 0, para->m * para->nbar * sizeof(uint16_t));
-    int32_t ret = PQCP_SUCCESS;
-    uint32_t hashLen = (para->m * para->nbar * 2 * para->eta1) >> 3;
-    uint8_t *tmp = BSL_SAL_Malloc(hashLen);
-    if (tmp == NULL) {
-        return PQCP_MEM_ALLOC_FAIL;
-    }
-    uint8_t *ptrTmp = tmp;
-    uint16_t *ptrMatrix = matrixE;
-    ret = SCLOUDPLUS_MdFunc(CRYPT_MD_SHAKE256, seed, SCLOUDPLUS_SEED_R2_LEN, NULL, 0, tmp, &hashLen);
-    if (ret != PQCP_SUCCESS) {
-        goto EXIT;
+    CBDStream st;
+    int32_t ret = CBDStreamInit(&st, mdCtx, seed, para->eta1);
+    if (ret == PQCP_SUCCESS) {
+        ret = CBDStreamSample(&st, matrixE, para->m * para->nbar);
     }
-    if (para->eta1 == 2) {
-        for (size_t i = 0; i < para->m * para->nbar; i = i + 2) {
-            CBD2(*ptrTmp, ptrMatrix);
-            ptrTmp = ptrTmp + 1;
-            ptrMatrix = ptrMatrix + 2;
-        }
-    } else if (para->eta1 == 3) {
-        for (size_t i = 0; i < para->m * para->nbar; i = i + 4) {
-            cbd3(U8ToU24(ptrTmp) & 0xFFFFFF, ptrMatrix);
-            ptrTmp = ptrTmp + 3;
-            ptrMatrix = ptrMatrix + 4;
-        }
-    } else if (para->eta1 == 7) {
-        for (size_t i = 0; i < para->m * para->nbar; i = i + 4) {
-            CBD7(U8ToU56(ptrTmp) & 0xFFFFFFFFFFFFFF, ptrMatrix);
-            ptrTmp = ptrTmp + 7;
-            ptrMatrix = ptrMatrix + 4;
-        }
-    } else {
-        ret = PQCP_SCLOUDPLUS_INVALID_ARG;
-    }
-EXIT:
-    BSL_SAL_FREE(tmp);
+    BSL_SAL_CleanseData(st.buf, sizeof(st.buf));
     return ret;
 }
 
-int32_t SCLOUDPLUS_SampleEta2(const uint8_t *seed, const SCLOUDPLUS_Para *para, uint16_t *matrixE1, uint16_t *matrixE2)
+int32_t SCLOUDPLUS_SampleEta2(const uint8_t *seed, const SCLOUDPLUS_Para *para, CRYPT_EAL_MdCtx *mdCtx,
+                              uint16_t *matrixE1, uint16_t *matrixE2)
 {
-    memset(matrixE1, 0, para->mbar * para->n * 2);
-    memset(matrixE2, 0, para->mbar * para->nbar * 2);
-    int32_t ret = 0;
-    const uint32_t hash1Len = ((para->mbar * para->n) * (2 * para->eta2)) >> 3;
-    const uint32_t hash2Len = ((para->mbar * para->nbar) * (2 * para->eta2) + 7) >> 3;
-    uint32_t hashLen = hash1Len + hash2Len;
-    uint8_t *tmp = BSL_SAL_Malloc(hash1Len + hash2Len);
-    if (tmp == NULL) {
-        return PQCP_MEM_ALLOC_FAIL;
-    }
-    uint8_t *ptrTmp1 = tmp;
-    uint8_t *ptrTmp2 = tmp + hash1Len;
-    uint16_t *ptrMatrix1 = matrixE1;
-    uint16_t *ptrMatrix2 = matrixE2;
-    ret = SCLOUDPLUS_MdFunc(CRYPT_MD_SHAKE256, seed, SCLOUDPLUS_SEED_R2_LEN, NULL, 0, tmp, &hashLen);
-    if (ret != PQCP_SUCCESS) {
-        goto EXIT;
+    CBDStream st;
+    int32_t ret = CBDStreamInit(&st, mdCtx, seed, para->eta2);
+    if (ret == PQCP_SUCCESS) {
+        ret = CBDStreamSample(&st, matrixE1, para->mbar * para->n);
     }
-    if (para->eta2 == 1) {
-        for (size_t i = 0; i < para->mbar * para->n; i = i + 4) {
-            CBD1(*ptrTmp1, ptrMatrix1);
-            ptrTmp1 = ptrTmp1 + 1;
-            ptrMatrix1 = ptrMatrix1 + 4;
-        }
-        for (size_t i = 0; i < para->mbar * para->nbar; i = i + 4) {
-            CBD1(*ptrTmp2, ptrMatrix2);
-            ptrTmp2 = ptrTmp2 + 1;
-            ptrMatrix2 = ptrMatrix2 + 4;
-        }
-    } else if (para->eta2 == 2) {
-        for (size_t i = 0; i < para->mbar * para->n; i = i + 2) {
-            CBD2(*ptrTmp1, ptrMatrix1);
-            ptrTmp1 = ptrTmp1 + 1;
-            ptrMatrix1 = ptrMatrix1 + 2;
-        }
-        for (size_t i = 0; i < para->mbar * para->nbar; i = i + 2) {
-            CBD2(*ptrTmp2, ptrMatrix2);
-            ptrTmp2 = ptrTmp2 + 1;
-            ptrMatrix2 = ptrMatrix2 + 2;
-        }
-    } else if (para->eta2 == 7) {
-        for (size_t i = 0; i < para->mbar * para->n; i = i + 4) {
-            CBD7(U8ToU56(ptrTmp1) & 0xFFFFFFFFFFFFFF, ptrMatrix1);
-            ptrTmp1 = ptrTmp1 + 7;
-            ptrMatrix1 = ptrMatrix1 + 4;
-        }
-        for (size_t i = 0; i < para->mbar * para->nbar; i = i + 4) {
-            CBD7(U8ToU56(ptrTmp2) & 0xFFFFFFFFFFFFFF, ptrMatrix2);
-            ptrTmp2 = ptrTmp2 + 7;
-            ptrMatrix2 = ptrMatrix2 + 4;
-        }
-    } else {
-        ret = PQCP_SCLOUDPLUS_INVALID_ARG;
+    if (ret == PQCP_SUCCESS) {
+        ret = CBDStreamSample(&st, matrixE2, para->mbar * para->nbar);
     }
-EXIT:
-    BSL_SAL_FREE(tmp);
+    BSL_SAL_CleanseData(st.buf, sizeof(st.buf));
     return ret;
 }
 
-int32_t SCLOUDPLUS_SamplePsi(const uint8_t *seed, const SCLOUDPLUS_Para *para, uint16_t *matrixS)
+int32_t SCLOUDPLUS_SamplePsi(const uint8_t *seed, const SCLOUDPLUS_Para *para, CRYPT_EAL_MdCtx *psiCtx,
+                             uint16_t *matrixS)
 {
     int32_t ret;
     memset(matrixS, 0, para->n * para->nbar * sizeof(uint16_t));
@@ -1447,22 +1991,17 @@ int32_t SCLOUDPLUS_SamplePsi(const uint8_t *seed, const SCLOUDPLUS_Para *para, u
     uint16_t tmp[para->mnout];
     int outLen, k = 0;
     const int inLen = sizeof(hash);
-    CRYPT_EAL_MdCtx *psiCtx = CRYPT_EAL_MdNewCtx(CRYPT_MD_SHAKE256);
-    if (psiCtx == NULL) {
-        ret = PQCP_MEM_ALLOC_FAIL;
-        goto EXIT;
-    }
     ret = CRYPT_EAL_MdInit(psiCtx);
     if (ret != PQCP_SUCCESS) {
-        goto EXIT;
+        return ret;
     }
     ret = CRYPT_EAL_MdUpdate(psiCtx, seed, SCLOUDPLUS_SEED_R1_LEN);
     if (ret != PQCP_SUCCESS) {
-        goto EXIT;
+        return ret;
     }
     ret = CRYPT_EAL_MdSqueeze(psiCtx, hash, inLen);
     if (ret != PQCP_SUCCESS) {
-        goto EXIT;
+        return ret;
     }
     U8ToN(hash, para->mnin, para, tmp, &outLen);
     for (int i = 0; i < para->nbar; i++) {
@@ -1471,7 +2010,7 @@ int32_t SCLOUDPLUS_SamplePsi(const uint8_t *seed, const SCLOUDPLUS_Para *para, u
             if (k == outLen) {
                 ret = CRYPT_EAL_MdSqueeze(psiCtx, hash, inLen);
                 if (ret != PQCP_SUCCESS) {
-                    goto EXIT;
+                    return ret;
                 }
                 U8ToN(hash, para->mnin, para, tmp, &outLen);
                 k = 0;
@@ -1485,12 +2024,11 @@ int32_t SCLOUDPLUS_SamplePsi(const uint8_t *seed, const SCLOUDPLUS_Para *para, u
             k++;
         }
     }
-EXIT:
-    CRYPT_EAL_MdFreeCtx(psiCtx);
     return ret;
 }
 
-int32_t SCLOUDPLUS_SamplePhi(const uint8_t *seed, const SCLOUDPLUS_Para *para, uint16_t *matrixs)
+int32_t SCLOUDPLUS_SamplePhi(const uint8_t *seed, const SCLOUDPLUS_Para *para, CRYPT_EAL_MdCtx *phiCtx,
+                             uint16_t *matrixs)
 {
     int32_t ret = 0;
     memset(matrixs, 0, para->m * para->mbar * 2);
@@ -1498,21 +2036,17 @@ int32_t SCLOUDPLUS_SamplePhi(const uint8_t *seed, const SCLOUDPLUS_Para *para, u
     uint16_t tmp[para->mnout];
     int outLen, k = 0;
     const int inLen = sizeof(hash);
-    CRYPT_EAL_MdCtx *phiCtx = CRYPT_EAL_MdNewCtx(CRYPT_MD_SHAKE256);
-    if (phiCtx == NULL) {
-        return PQCP_MEM_ALLOC_FAIL;
-    }
     ret = CRYPT_EAL_MdInit(phiCtx);
     if (ret != PQCP_SUCCESS) {
-        goto EXIT;
+        return ret;
     }
     ret = CRYPT_EAL_MdUpdate(phiCtx, seed, 32);
     if (ret != PQCP_SUCCESS) {
-        goto EXIT;
+        return ret;
     }
     ret = CRYPT_EAL_MdSqueeze(phiCtx, hash, inLen);
     if (ret != PQCP_SUCCESS) {
-        goto EXIT;
+        return ret;
     }
     U8ToM(hash, para->mnin, para, tmp, &outLen);
     for (int i = 0; i < para->mbar; i++) {
@@ -1521,7 +2055,7 @@ int32_t SCLOUDPLUS_SamplePhi(const uint8_t *seed, const SCLOUDPLUS_Para *para, u
             if (k == outLen) {
                 ret = CRYPT_EAL_MdSqueeze(phiCtx, hash, inLen);
                 if (ret != PQCP_SUCCESS) {
-                    goto EXIT;
+                    return ret;
                 }
                 U8ToM(hash, para->mnin, para, tmp, &outLen);
                 k = 0;
@@ -1536,35 +2070,237 @@ int32_t SCLOUDPLUS_SamplePhi(const uint8_t *seed, const SCLOUDPLUS_Para *para, u
             k++;
         }
     }
-EXIT:
-    CRYPT_EAL_MdFreeCtx(phiCtx);
     return ret;
 }
 
-int32_t SCLOUDPLUS_MdFunc(const CRYPT_MD_AlgId id, const uint8_t *input1, const uint32_t inLen1, const uint8_t *input2,
-    const uint32_t inLen2, uint8_t *output, uint32_t *outLen)
+// 在已创建的MdCtx上重新初始化并计算摘要，供复用上下文的调用者使用
+int32_t SCLOUDPLUS_MdCtxFunc(CRYPT_EAL_MdCtx *MdCtx, const uint8_t *input1, const uint32_t inLen1,
+    const uint8_t *input2, const uint32_t inLen2, uint8_t *output, uint32_t *outLen)
 {
-    CRYPT_EAL_MdCtx *MdCtx = CRYPT_EAL_MdNewCtx(id);
-    if (MdCtx == NULL) {
-        return BSL_MALLOC_FAIL;
-    }
     int32_t ret = CRYPT_EAL_MdInit(MdCtx);
     if (ret != PQCP_SUCCESS) {
-        goto EXIT;
+        return ret;
     }
     ret = CRYPT_EAL_MdUpdate(MdCtx, input1, inLen1);
     if (ret != PQCP_SUCCESS) {
-        goto EXIT;
+        return ret;
     }
     if (input2 != NULL) {
         ret = CRYPT_EAL_MdUpdate(MdCtx, input2, inLen2);
         if (ret != PQCP_SUCCESS) {
-            goto EXIT;
+            return ret;
         }
     }
-    ret = CRYPT_EAL_MdFinal(MdCtx, output, outLen);
-EXIT:
+    return CRYPT_EAL_MdFinal(MdCtx, output, outLen);
+}
+
+int32_t SCLOUDPLUS_MdFunc(const CRYPT_MD_AlgId id, const uint8_t *input1, const uint32_t inLen1, const uint8_t *input2,
+    const uint32_t inLen2, uint8_t *output, uint32_t *outLen)
+{
+    CRYPT_EAL_MdCtx *MdCtx = CRYPT_EAL_MdNewCtx(id);
+    if (MdCtx == NULL) {
+        return BSL_MALLOC_FAIL;
+    }
+    int32_t ret = SCLOUDPLUS_MdCtxFunc(MdCtx, input1, inLen1, input2, inLen2, output, outLen);
     CRYPT_EAL_MdFreeCtx(MdCtx);
     return ret;
 }
+
+// 预定义三组参数配置
+static const SCLOUDPLUS_Para PRESET_PARAS[SCLOUDPLUS_PARA_MAX] = {
+    {
+        .ss = 16,
+        .mbar = 8,
+        .nbar = 8,
+        .m = 600,
+        .n = 600,
+        .logq = 12,
+        .logq1 = 9,
+        .logq2 = 7,
+        .h1 = 150,
+        .h2 = 150,
+        .eta1 = 7,
+        .eta2 = 7,
+        .mu = 64,
+        .muConut = 2,
+        .tau = 3,
+        .mnin = 679,
+        .mnout = 582,
+        .c1Size = 5400,
+        .c2Size = 56,
+        .ctxSize = 5456,
+        .pkSize = 7216,
+        .pkeSkSize = 1200,
+        .kemSkSize = 8480
+    },
+    {
+        .ss = 24,
+        .mbar = 8,
+        .nbar = 8,
+        .m = 928,
+        .n = 896,
+        .logq = 12,
+        .logq1 = 12,
+        .logq2 = 10,
+        .h1 = 224,
+        .h2 = 232,
+        .eta1 = 2,
+        .eta2 = 1,
+        .mu = 96,
+        .muConut = 2,
+        .tau = 4,
+        .mnin = 671,
+        .mnout = 488,
+        .c1Size = 10752,
+        .c2Size = 80,
+        .ctxSize = 10832,
+        .pkSize = 11152,
+        .pkeSkSize = 1792,
+        .kemSkSize = 13008
+    },
+    {
+        .ss = 32,
+        .mbar = 12,
+        .nbar = 11,
+        .m = 1136,
+        .n = 1120,
+        .logq = 12,
+        .logq1 = 10,
+        .logq2 = 7,
+        .h1 = 280,
+        .h2 = 284,
+        .eta1 = 3,
+        .eta2 = 2,
+        .mu = 64,
+        .muConut = 4,
+        .tau = 3,
+        .mnin = 680,
+        .mnout = 530,
+        .c1Size = 16800,
+        .c2Size = 116,
+        .ctxSize = 16916,
+        .pkSize = 18760,
+        .pkeSkSize = 3080,
+        .kemSkSize = 21904
+    }
+};
+
+/*
+ * 内核实例化：通用版本从para读取参数集；预定义参数集的版本忽略para，改用PRESET_PARAS中的常量参数集，
+ * 使n、nbar、mbar、h1、h2等循环边界在编译期确定，便于编译器展开循环并去除向量化的尾部处理。
+ */
+#define SCLOUDPLUS_KERNELS_DEFINE(storage, prefix, PARA)                                                          \
+    storage int32_t prefix##AS_E_Rows(const uint8_t *seedA, const uint16_t *S, const SCLOUDPLUS_Para *para,         \
+        const uint32_t rowBegin, const uint32_t rowEnd, uint16_t *B, uint16_t *tmp)                              \
+    {                                                                                                            \
+        (void)para;                                                                                              \
+        return KernelAS_E_Rows(seedA, S, PARA, rowBegin, rowEnd, B, tmp);                                        \
+    }                                                                                                            \
+    storage int32_t prefix##SA_E_Rows(const uint8_t *seedA, const uint16_t *cacheA, const uint32_t cacheRows,       \
+        const uint32_t num, const uint16_t *S, uint16_t *E, const SCLOUDPLUS_Para *para, const uint32_t rowBegin,    \
+        const uint32_t rowEnd, uint16_t *tmp)                                                                    \
+    {                                                                                                            \
+        (void)para;                                                                                              \
+        return KernelSA_E_Rows(seedA, cacheA, cacheRows, num, S, E, PARA, rowBegin, rowEnd, tmp);                \
+    }                                                                                                            \
+    storage void prefix##CS(const uint16_t *C, const uint16_t *S, const SCLOUDPLUS_Para *para, uint16_t *out,     \
+        uint16_t *tmp)                                                                                           \
+    {                                                                                                            \
+        (void)para;                                                                                              \
+        KernelCS(C, S, PARA, out, tmp);                                                                          \
+    }                                                                                                            \
+    storage void prefix##SB_E(const uint16_t *S, const uint16_t *B, const uint16_t *E,                           \
+        const SCLOUDPLUS_Para *para, uint16_t *out)                                                              \
+    {                                                                                                            \
+        (void)para;                                                                                              \
+        KernelSB_E(S, B, E, PARA, out);                                                                          \
+    }                                                                                                            \
+    storage void prefix##PackPK(const uint16_t *B, const SCLOUDPLUS_Para *para, uint8_t *pk)                     \
+    {                                                                                                            \
+        (void)para;                                                                                              \
+        KernelPackPK(B, PARA, pk);                                                                               \
+    }                                                                                                            \
+    storage void prefix##UnPackPK(const uint8_t *pk, const SCLOUDPLUS_Para *para, uint16_t *B)                   \
+    {                                                                                                            \
+        (void)para;                                                                                              \
+        KernelUnPackPK(pk, PARA, B);                                                                             \
+    }                                                                                                            \
+    storage void prefix##PackSK(const uint16_t *S, const SCLOUDPLUS_Para *para, uint8_t *sk)                     \
+    {                                                                                                            \
+        (void)para;                                                                                              \
+        KernelPackSK(S, PARA, sk);                                                                               \
+    }                                                                                                            \
+    storage void prefix##UnPackSK(const uint8_t *sk, const SCLOUDPLUS_Para *para, uint16_t *S)                   \
+    {                                                                                                            \
+        (void)para;                                                                                              \
+        KernelUnPackSK(sk, PARA, S);                                                                             \
+    }                                                                                                            \
+    storage void prefix##CompressPackC1(const uint16_t *C, const SCLOUDPLUS_Para *para, uint8_t *out)            \
+    {                                                                                                            \
+        (void)para;                                                                                              \
+        KernelCompressPackC1(C, PARA, out);                                                                      \
+    }                                                                                                            \
+    storage void prefix##UnPackDeCompressC1(const uint8_t *in, const SCLOUDPLUS_Para *para, uint16_t *C)         \
+    {                                                                                                            \
+        (void)para;                                                                                              \
+        KernelUnPackDeCompressC1(in, PARA, C);                                                                   \
+    }                                                                                                            \
+    storage void prefix##CompressPackC2(const uint16_t *C, const SCLOUDPLUS_Para *para, uint8_t *out)            \
+    {                                                                                                            \
+        (void)para;                                                                                              \
+        KernelCompressPackC2(C, PARA, out);                                                                      \
+    }                                                                                                            \
+    storage void prefix##UnPackDeCompressC2(const uint8_t *in, const SCLOUDPLUS_Para *para, uint16_t *C)         \
+    {                                                                                                            \
+        (void)para;                                                                                              \
+        KernelUnPackDeCompressC2(in, PARA, C);                                                                   \
+    }                                                                                                            \
+    storage uint8_t prefix##CompressCmpC1(const uint16_t *C, const SCLOUDPLUS_Para *para, const uint8_t *ct)     \
+    {                                                                                                            \
+        (void)para;                                                                                              \
+        return KernelCompressCmpC1(C, PARA, ct);                                                                 \
+    }                                                                                                            \
+    storage uint8_t prefix##CompressCmpC2(const uint16_t *C, const SCLOUDPLUS_Para *para, const uint8_t *ct)     \
+    {                                                                                                            \
+        (void)para;                                                                                              \
+        return KernelCompressCmpC2(C, PARA, ct);                                                                 \
+    }                                                                                                            \
+    static const SCLOUDPLUS_Kernels prefix##KERNELS = {                                                          \
+        prefix##AS_E_Rows, prefix##SA_E_Rows, prefix##CS, prefix##SB_E, prefix##PackPK, prefix##UnPackPK,        \
+        prefix##PackSK, prefix##UnPackSK, prefix##CompressPackC1, prefix##UnPackDeCompressC1,                    \
+        prefix##CompressPackC2, prefix##UnPackDeCompressC2, prefix##CompressCmpC1, prefix##CompressCmpC2          \
+    }
+
+SCLOUDPLUS_KERNELS_DEFINE(, SCLOUDPLUS_, para);
+#ifndef SCLOUDPLUS_GENERIC_KERNELS
+SCLOUDPLUS_KERNELS_DEFINE(static, SET1_, &PRESET_PARAS[SCLOUDPLUS_PARA_SET1]);
+SCLOUDPLUS_KERNELS_DEFINE(static, SET2_, &PRESET_PARAS[SCLOUDPLUS_PARA_SET2]);
+SCLOUDPLUS_KERNELS_DEFINE(static, SET3_, &PRESET_PARAS[SCLOUDPLUS_PARA_SET3]);
+#endif
+
+const SCLOUDPLUS_Para *SCLOUDPLUS_GetPara(const SCLOUDPLUS_PARA_SET set)
+{
+    return (set < SCLOUDPLUS_PARA_MAX) ? &PRESET_PARAS[set] : NULL;
+}
+
+const SCLOUDPLUS_Kernels *SCLOUDPLUS_GetKernels(const SCLOUDPLUS_PARA_SET set)
+{
+#ifndef SCLOUDPLUS_GENERIC_KERNELS
+    static const SCLOUDPLUS_Kernels *const KERNELS[SCLOUDPLUS_PARA_MAX] = {&SET1_KERNELS, &SET2_KERNELS, &SET3_KERNELS};
+    if (set < SCLOUDPLUS_PARA_MAX) {
+        return KERNELS[set];
+    }
+#else
+    (void)set;
+#endif
+    return &SCLOUDPLUS_KERNELS;
+}
+
+uint32_t SCLOUDPLUS_KernelTmpLen(const SCLOUDPLUS_Para *para)
+{
+    uint32_t len = SCLOUDPLUS_SA_E_TILE_ROWS * para->n + MATRIX_A_GEN_LEN(para); // SA_E的行块与生成器，AS_E/ExpandA更少
+    const uint32_t csLen = para->n * SCLOUDPLUS_CS_STRIDE(para);
+    len = (csLen > len) ? csLen : len;
+    return len;
+}
 #endif // PQCP_SCLOUDPLUS
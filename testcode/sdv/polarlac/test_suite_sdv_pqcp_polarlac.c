@@ -28,6 +28,8 @@
 #include "pqcp_provider.h"
 #include "pqcp_types.h"
 #include "pqcp_err.h"
+#include "crypt_polarlac.h"
+#include "polarlac_local.h"
 /* END_HEADER */
 #ifdef PQCP_POLARLAC
 static int32_t TEST_PolarLacRandom(uint8_t *rand, uint32_t randLen)
@@ -37,6 +39,51 @@ static int32_t TEST_PolarLacRandom(uint8_t *rand, uint32_t randLen)
     }
     return 0;
 }
+
+// key generation draws the seed and encapsulation the message, served in turn from these buffers
+static uint8_t gPolarLacRandBuf[2][32] = {0};
+static uint32_t gPolarLacRandNum = 0;
+
+static int32_t TEST_PolarLacVectorRandom(uint8_t *rand, uint32_t randLen)
+{
+    if (randLen > sizeof(gPolarLacRandBuf[0])) {
+        return -1;
+    }
+    memcpy(rand, gPolarLacRandBuf[gPolarLacRandNum % 2], randLen);
+    gPolarLacRandNum++;
+    return 0;
+}
+
+// fill the key generation seed with seed + i and the encapsulation message with 0xA5 ^ i
+static void TEST_PolarLacSetRandBuf(uint8_t seed)
+{
+    for (uint32_t i = 0; i < sizeof(gPolarLacRandBuf[0]); i++) {
+        gPolarLacRandBuf[0][i] = (uint8_t)(seed + i);
+        gPolarLacRandBuf[1][i] = (uint8_t)(0xA5 ^ i);
+    }
+}
+
+// encapsulate the message of gPolarLacRandBuf, so that the same public key always gives the same ciphertext
+static int32_t TEST_PolarLacEncaps(CRYPT_POLAR_LAC_Ctx *ctx, uint8_t *cipher, uint32_t *cipherLen, uint8_t *sharedKey,
+    uint32_t *sharedLen)
+{
+    gPolarLacRandNum = 1;
+    *cipherLen = 4096;
+    *sharedLen = 32;
+    return PQCP_LAC2_Encaps(ctx, cipher, cipherLen, sharedKey, sharedLen);
+}
+
+// decapsulate cipher and compare the shared key with expSharedKey
+static bool TEST_PolarLacDecapsMatch(CRYPT_POLAR_LAC_Ctx *ctx, const uint8_t *cipher, uint32_t cipherLen,
+    const uint8_t *expSharedKey)
+{
+    uint8_t sharedKey[32] = {0};
+    uint32_t sharedLen = sizeof(sharedKey);
+    if (PQCP_LAC2_Decaps(ctx, cipher, cipherLen, sharedKey, &sharedLen) != PQCP_SUCCESS) {
+        return false;
+    }
+    return sharedLen == sizeof(sharedKey) && memcmp(sharedKey, expSharedKey, sharedLen) == 0;
+}
 #endif
 /* @
 * @test  SDV_CRYPTO_PQCP_POLARLAC_KEYGEN_API_TC001
@@ -329,3 +376,383 @@ EXIT:
 #endif
 }
 /* END_CASE */
+
+/* @
+* @test  SDV_CRYPTO_PQCP_POLARLAC_VECTOR_TC001
+* @spec  -
+* @title  PQCP Polarlac Known Answer Test
+* @precon  nan
+* @brief  1. Set the random callback to return the given seed and message
+*         2. KeyGen and compare pk and sk with expected values
+*         3. Encaps on a context holding only pk and compare ct and ss with expected values
+*         4. Decaps the expected ct on the KeyGen context and on a context built from sk
+* @expect  pk, sk, ct and ss match expected values
+* @prior  nan
+* @auto  FALSE
+@ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_PQCP_POLARLAC_VECTOR_TC001(int algId, Hex *seed, Hex *msg, Hex *expPk, Hex *expSk, Hex *expCipher,
+    Hex *expSharedKey)
+{
+#ifdef PQCP_POLARLAC
+    TestMemInit();
+    CRYPT_EAL_PkeyCtx *ctx = NULL;
+    CRYPT_EAL_PkeyCtx *pubCtx = NULL;
+    CRYPT_EAL_PkeyCtx *prvCtx = NULL;
+    uint8_t cipher[4096] = {0};
+    uint8_t sharedKey[32] = {0};
+    uint8_t pubData[8192] = {0};
+    uint8_t prvData[8192] = {0};
+    ASSERT_TRUE(seed->len <= sizeof(gPolarLacRandBuf[0]));
+    ASSERT_TRUE(msg->len <= sizeof(gPolarLacRandBuf[1]));
+    memcpy(gPolarLacRandBuf[0], seed->x, seed->len);
+    memcpy(gPolarLacRandBuf[1], msg->x, msg->len);
+    gPolarLacRandNum = 0;
+    CRYPT_EAL_SetRandCallBack(TEST_PolarLacVectorRandom);
+
+    ctx = CRYPT_EAL_ProviderPkeyNewCtx(NULL, PQCP_PKEY_POLAR_LAC, CRYPT_EAL_PKEY_KEM_OPERATE, "provider=pqcp");
+    pubCtx = CRYPT_EAL_ProviderPkeyNewCtx(NULL, PQCP_PKEY_POLAR_LAC, CRYPT_EAL_PKEY_KEM_OPERATE, "provider=pqcp");
+    prvCtx = CRYPT_EAL_ProviderPkeyNewCtx(NULL, PQCP_PKEY_POLAR_LAC, CRYPT_EAL_PKEY_KEM_OPERATE, "provider=pqcp");
+    ASSERT_TRUE(ctx != NULL);
+    ASSERT_TRUE(pubCtx != NULL);
+    ASSERT_TRUE(prvCtx != NULL);
+    int32_t val = algId;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(pubCtx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(prvCtx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyGen(ctx), PQCP_SUCCESS);
+
+    BSL_Param pub[2] = {
+        {PQCP_PARAM_POLAR_LAC_PUBKEY, BSL_PARAM_TYPE_OCTETS, pubData, sizeof(pubData), 0},
+        BSL_PARAM_END
+    };
+    BSL_Param prv[2] = {
+        {PQCP_PARAM_POLAR_LAC_PRVKEY, BSL_PARAM_TYPE_OCTETS, prvData, sizeof(prvData), 0},
+        BSL_PARAM_END
+    };
+    ASSERT_EQ(CRYPT_EAL_PkeyGetPubEx(ctx, pub), PQCP_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyGetPrvEx(ctx, prv), PQCP_SUCCESS);
+    ASSERT_COMPARE("compare pk", pubData, pub[0].useLen, expPk->x, expPk->len);
+    ASSERT_COMPARE("compare sk", prvData, prv[0].useLen, expSk->x, expSk->len);
+    pub[0].valueLen = pub[0].useLen;
+    prv[0].valueLen = prv[0].useLen;
+    ASSERT_EQ(CRYPT_EAL_PkeySetPubEx(pubCtx, pub), PQCP_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeySetPrvEx(prvCtx, prv), PQCP_SUCCESS);
+
+    uint32_t cipherLen = sizeof(cipher);
+    uint32_t sharedLen = sizeof(sharedKey);
+    ASSERT_EQ(CRYPT_EAL_PkeyEncapsInit(pubCtx, NULL), PQCP_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyEncaps(pubCtx, cipher, &cipherLen, sharedKey, &sharedLen), PQCP_SUCCESS);
+    ASSERT_COMPARE("compare ct", cipher, cipherLen, expCipher->x, expCipher->len);
+    ASSERT_COMPARE("compare ss", sharedKey, sharedLen, expSharedKey->x, expSharedKey->len);
+
+    ASSERT_EQ(CRYPT_EAL_PkeyDecapsInit(ctx, NULL), PQCP_SUCCESS);
+    sharedLen = sizeof(sharedKey);
+    ASSERT_EQ(CRYPT_EAL_PkeyDecaps(ctx, expCipher->x, expCipher->len, sharedKey, &sharedLen), PQCP_SUCCESS);
+    ASSERT_COMPARE("compare dec ss", sharedKey, sharedLen, expSharedKey->x, expSharedKey->len);
+    ASSERT_EQ(CRYPT_EAL_PkeyDecapsInit(prvCtx, NULL), PQCP_SUCCESS);
+    sharedLen = sizeof(sharedKey);
+    ASSERT_EQ(CRYPT_EAL_PkeyDecaps(prvCtx, expCipher->x, expCipher->len, sharedKey, &sharedLen), PQCP_SUCCESS);
+    ASSERT_COMPARE("compare dec ss", sharedKey, sharedLen, expSharedKey->x, expSharedKey->len);
+
+EXIT:
+    CRYPT_EAL_PkeyFreeCtx(ctx);
+    CRYPT_EAL_PkeyFreeCtx(pubCtx);
+    CRYPT_EAL_PkeyFreeCtx(prvCtx);
+    CRYPT_EAL_SetRandCallBack(NULL);
+    return;
+#else
+    SKIP_TEST();
+    (void)algId;
+    (void)seed;
+    (void)msg;
+    (void)expPk;
+    (void)expSk;
+    (void)expCipher;
+    (void)expSharedKey;
+#endif
+}
+/* END_CASE */
+
+/* @
+* @test  SDV_CRYPTO_PQCP_POLARLAC_DECODE_TC001
+* @spec  -
+* @title  PQCP Polarlac Polar Decoder Known Answer Test
+* @precon  nan
+* @brief  1. Draw codeLen llr from the int8 values in alphabet with a fixed LCG, so that llr 0 and equal
+*            magnitudes are frequent
+*         2. Decode and pack the message bits as the PKE does
+*         3. Compare with the expected message
+* @expect  Ties resolve deterministically and the message matches the expected value
+* @prior  nan
+* @auto  FALSE
+@ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_PQCP_POLARLAC_DECODE_TC001(int algId, int codeLen, Hex *alphabet, int seed, Hex *expMsg)
+{
+#ifdef PQCP_POLARLAC
+    TestMemInit();
+    int16_t llr[512] = {0};
+    uint8_t mCap[512] = {0};
+    uint8_t msg[64] = {0};
+    uint32_t state = (uint32_t)seed;
+    ASSERT_TRUE(codeLen > 0 && codeLen <= (int)(sizeof(llr) / sizeof(llr[0])));
+    ASSERT_TRUE(alphabet->len > 0);
+    ASSERT_TRUE(expMsg->len <= sizeof(msg));
+    for (int i = 0; i < codeLen; i++) {
+        state = state * 1103515245u + 12345u;
+        llr[i] = (int8_t)alphabet->x[(state >> 16) % alphabet->len];
+    }
+    PQCP_POLAR_LAC_DecodePolar(mCap, llr, algId);
+    for (uint32_t i = 0; i < expMsg->len * 8; i++) {
+        msg[i / 8] |= (uint8_t)(mCap[i] << (i % 8));
+    }
+    ASSERT_COMPARE("compare decoded message", msg, expMsg->len, expMsg->x, expMsg->len);
+
+EXIT:
+    return;
+#else
+    SKIP_TEST();
+    (void)algId;
+    (void)codeLen;
+    (void)alphabet;
+    (void)seed;
+    (void)expMsg;
+#endif
+}
+/* END_CASE */
+
+/* @
+* @test  SDV_CRYPTO_PQCP_POLARLAC_DECODE_NODES_TC001
+* @spec  -
+* @title  PQCP Polarlac Pruned Decoding Tree Check
+* @precon  nan
+* @brief  1. Walk the pruned decoding tree of the parameter set against its frozen bit pattern
+* @expect  The nodes cover the code in order and each node type matches its frozen bits
+* @prior  nan
+* @auto  FALSE
+@ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_PQCP_POLARLAC_DECODE_NODES_TC001(int algId)
+{
+#ifdef PQCP_POLARLAC
+    TestMemInit();
+    ASSERT_EQ(PQCP_POLAR_LAC_CheckPolarNodes(algId), PQCP_SUCCESS);
+
+EXIT:
+    return;
+#else
+    SKIP_TEST();
+    (void)algId;
+#endif
+}
+/* END_CASE */
+
+/* @
+* @test  SDV_CRYPTO_PQCP_POLARLAC_PK_NTT_CACHE_TC001
+* @spec  -
+* @title  PQCP Polarlac Public Key NTT Cache Test
+* @precon  nan
+* @brief  1. KeyGen, then encaps a fixed message on a context holding only pk
+*         2. Encaps again with the cached NTT of pk dropped, and on a context built from sk
+*         3. Encaps on a DupCtx copy of the KeyGen context and of the context without cache
+*         4. Decaps the ciphertext on a context built from sk
+*         5. KeyGen again on the first context with another seed, then encaps on it and on a context holding only
+*            the new pk
+* @expect  Every encaps of the same pk gives the same ct and ss, and the second KeyGen refreshes the cache
+* @prior  nan
+* @auto  FALSE
+@ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_PQCP_POLARLAC_PK_NTT_CACHE_TC001(int algId)
+{
+#ifdef PQCP_POLARLAC
+    TestMemInit();
+    CRYPT_POLAR_LAC_Ctx *ctx = NULL;
+    CRYPT_POLAR_LAC_Ctx *pubCtx = NULL;
+    CRYPT_POLAR_LAC_Ctx *prvCtx = NULL;
+    CRYPT_POLAR_LAC_Ctx *dupCtx = NULL;
+    CRYPT_POLAR_LAC_Ctx *dupPubCtx = NULL;
+    uint8_t pubData[4096] = {0};
+    uint8_t prvData[4096] = {0};
+    uint8_t cipher[4096] = {0};
+    uint8_t cipher2[4096] = {0};
+    uint8_t sharedKey[32] = {0};
+    uint8_t sharedKey2[32] = {0};
+    uint32_t cipherLen = 0;
+    uint32_t cipherLen2 = 0;
+    uint32_t sharedLen = 0;
+    uint32_t sharedLen2 = 0;
+    int32_t val = algId;
+    TEST_PolarLacSetRandBuf(0);
+    CRYPT_EAL_SetRandCallBack(TEST_PolarLacVectorRandom);
+
+    ctx = PQCP_LAC2_NewCtx();
+    pubCtx = PQCP_LAC2_NewCtx();
+    prvCtx = PQCP_LAC2_NewCtx();
+    ASSERT_TRUE(ctx != NULL && pubCtx != NULL && prvCtx != NULL);
+    ASSERT_EQ(PQCP_LAC2_Ctrl(ctx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_LAC2_Ctrl(pubCtx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_LAC2_Ctrl(prvCtx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    gPolarLacRandNum = 0;
+    ASSERT_EQ(PQCP_LAC2_Gen(ctx), PQCP_SUCCESS);
+    BSL_Param pub[2] = {
+        {PQCP_PARAM_POLAR_LAC_PUBKEY, BSL_PARAM_TYPE_OCTETS, pubData, sizeof(pubData), 0},
+        BSL_PARAM_END
+    };
+    BSL_Param prv[2] = {
+        {PQCP_PARAM_POLAR_LAC_PRVKEY, BSL_PARAM_TYPE_OCTETS, prvData, sizeof(prvData), 0},
+        BSL_PARAM_END
+    };
+    ASSERT_EQ(PQCP_LAC2_GetPubKey(ctx, pub), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_LAC2_GetPrvKey(ctx, prv), PQCP_SUCCESS);
+    pub[0].valueLen = pub[0].useLen;
+    prv[0].valueLen = prv[0].useLen;
+    ASSERT_EQ(PQCP_LAC2_SetPubKey(pubCtx, pub), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_LAC2_SetPrvKey(prvCtx, prv), PQCP_SUCCESS);
+
+    // encaps on the public key only context, with and without the cached NTT of pk
+    ASSERT_TRUE(pubCtx->pkNttReady);
+    ASSERT_EQ(TEST_PolarLacEncaps(pubCtx, cipher, &cipherLen, sharedKey, &sharedLen), PQCP_SUCCESS);
+    pubCtx->pkNttReady = false;
+    ASSERT_EQ(TEST_PolarLacEncaps(pubCtx, cipher2, &cipherLen2, sharedKey2, &sharedLen2), PQCP_SUCCESS);
+    ASSERT_COMPARE("compare uncached ct", cipher2, cipherLen2, cipher, cipherLen);
+    ASSERT_COMPARE("compare uncached ss", sharedKey2, sharedLen2, sharedKey, sharedLen);
+    ASSERT_EQ(TEST_PolarLacEncaps(prvCtx, cipher2, &cipherLen2, sharedKey2, &sharedLen2), PQCP_SUCCESS);
+    ASSERT_COMPARE("compare SetPrvKey ct", cipher2, cipherLen2, cipher, cipherLen);
+
+    // the copies keep the cache state of their source
+    dupCtx = PQCP_LAC2_DupCtx(ctx);
+    dupPubCtx = PQCP_LAC2_DupCtx(pubCtx);
+    ASSERT_TRUE(dupCtx != NULL && dupPubCtx != NULL);
+    ASSERT_TRUE(dupCtx->pkNttReady);
+    ASSERT_TRUE(!dupPubCtx->pkNttReady);
+    ASSERT_EQ(TEST_PolarLacEncaps(dupCtx, cipher2, &cipherLen2, sharedKey2, &sharedLen2), PQCP_SUCCESS);
+    ASSERT_COMPARE("compare dup ct", cipher2, cipherLen2, cipher, cipherLen);
+    ASSERT_EQ(TEST_PolarLacEncaps(dupPubCtx, cipher2, &cipherLen2, sharedKey2, &sharedLen2), PQCP_SUCCESS);
+    ASSERT_COMPARE("compare dup uncached ct", cipher2, cipherLen2, cipher, cipherLen);
+    sharedLen2 = sizeof(sharedKey2);
+    ASSERT_EQ(PQCP_LAC2_Decaps(dupCtx, cipher, cipherLen, sharedKey2, &sharedLen2), PQCP_SUCCESS);
+    ASSERT_COMPARE("compare dup ss", sharedKey2, sharedLen2, sharedKey, sharedLen);
+    sharedLen2 = sizeof(sharedKey2);
+    ASSERT_EQ(PQCP_LAC2_Decaps(prvCtx, cipher, cipherLen, sharedKey2, &sharedLen2), PQCP_SUCCESS);
+    ASSERT_COMPARE("compare SetPrvKey ss", sharedKey2, sharedLen2, sharedKey, sharedLen);
+
+    // a second KeyGen must not encrypt under the NTT of the previous pk
+    TEST_PolarLacSetRandBuf(1);
+    gPolarLacRandNum = 0;
+    ASSERT_EQ(PQCP_LAC2_Gen(ctx), PQCP_SUCCESS);
+    pub[0].valueLen = sizeof(pubData);
+    ASSERT_EQ(PQCP_LAC2_GetPubKey(ctx, pub), PQCP_SUCCESS);
+    pub[0].valueLen = pub[0].useLen;
+    PQCP_LAC2_FreeCtx(pubCtx);
+    pubCtx = PQCP_LAC2_NewCtx();
+    ASSERT_TRUE(pubCtx != NULL);
+    ASSERT_EQ(PQCP_LAC2_Ctrl(pubCtx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_LAC2_SetPubKey(pubCtx, pub), PQCP_SUCCESS);
+    ASSERT_EQ(TEST_PolarLacEncaps(ctx, cipher, &cipherLen, sharedKey, &sharedLen), PQCP_SUCCESS);
+    ASSERT_EQ(TEST_PolarLacEncaps(pubCtx, cipher2, &cipherLen2, sharedKey2, &sharedLen2), PQCP_SUCCESS);
+    ASSERT_COMPARE("compare regenerated ct", cipher2, cipherLen2, cipher, cipherLen);
+    sharedLen2 = sizeof(sharedKey2);
+    ASSERT_EQ(PQCP_LAC2_Decaps(ctx, cipher, cipherLen, sharedKey2, &sharedLen2), PQCP_SUCCESS);
+    ASSERT_COMPARE("compare regenerated ss", sharedKey2, sharedLen2, sharedKey, sharedLen);
+
+EXIT:
+    PQCP_LAC2_FreeCtx(ctx);
+    PQCP_LAC2_FreeCtx(pubCtx);
+    PQCP_LAC2_FreeCtx(prvCtx);
+    PQCP_LAC2_FreeCtx(dupCtx);
+    PQCP_LAC2_FreeCtx(dupPubCtx);
+    CRYPT_EAL_SetRandCallBack(NULL);
+    return;
+#else
+    SKIP_TEST();
+    (void)algId;
+#endif
+}
+/* END_CASE */
+
+/* @
+* @test  SDV_CRYPTO_PQCP_POLARLAC_SK_NTT_CACHE_TC001
+* @spec  -
+* @title  PQCP Polarlac Secret Key NTT Cache Test
+* @precon  nan
+* @brief  1. KeyGen, encaps, and build a second ciphertext with one byte changed
+*         2. Decaps both ciphertexts on the KeyGen context and on a context built from sk
+*         3. Decaps again with the cached NTT of s dropped, and on DupCtx copies with and without the cache
+* @expect  The honest ciphertext always gives ss, the changed one always gives the same implicit rejection key
+* @prior  nan
+* @auto  FALSE
+@ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_PQCP_POLARLAC_SK_NTT_CACHE_TC001(int algId)
+{
+#ifdef PQCP_POLARLAC
+    TestMemInit();
+    CRYPT_POLAR_LAC_Ctx *ctx = NULL;
+    CRYPT_POLAR_LAC_Ctx *prvCtx = NULL;
+    CRYPT_POLAR_LAC_Ctx *dupCtx = NULL;
+    CRYPT_POLAR_LAC_Ctx *dupPrvCtx = NULL;
+    uint8_t prvData[4096] = {0};
+    uint8_t cipher[4096] = {0};
+    uint8_t badCipher[4096] = {0};
+    uint8_t sharedKey[32] = {0};
+    uint8_t rejectKey[32] = {0};
+    uint32_t cipherLen = 0;
+    uint32_t sharedLen = 0;
+    uint32_t rejectLen = sizeof(rejectKey);
+    int32_t val = algId;
+    TEST_PolarLacSetRandBuf(0);
+    CRYPT_EAL_SetRandCallBack(TEST_PolarLacVectorRandom);
+
+    ctx = PQCP_LAC2_NewCtx();
+    prvCtx = PQCP_LAC2_NewCtx();
+    ASSERT_TRUE(ctx != NULL && prvCtx != NULL);
+    ASSERT_EQ(PQCP_LAC2_Ctrl(ctx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_LAC2_Ctrl(prvCtx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    gPolarLacRandNum = 0;
+    ASSERT_EQ(PQCP_LAC2_Gen(ctx), PQCP_SUCCESS);
+    BSL_Param prv[2] = {
+        {PQCP_PARAM_POLAR_LAC_PRVKEY, BSL_PARAM_TYPE_OCTETS, prvData, sizeof(prvData), 0},
+        BSL_PARAM_END
+    };
+    ASSERT_EQ(PQCP_LAC2_GetPrvKey(ctx, prv), PQCP_SUCCESS);
+    prv[0].valueLen = prv[0].useLen;
+    ASSERT_EQ(PQCP_LAC2_SetPrvKey(prvCtx, prv), PQCP_SUCCESS);
+    ASSERT_TRUE(ctx->skNttReady && prvCtx->skNttReady);
+
+    ASSERT_EQ(TEST_PolarLacEncaps(ctx, cipher, &cipherLen, sharedKey, &sharedLen), PQCP_SUCCESS);
+    memcpy(badCipher, cipher, cipherLen);
+    badCipher[cipherLen - 1] ^= 0x11;
+    ASSERT_EQ(PQCP_LAC2_Decaps(ctx, badCipher, cipherLen, rejectKey, &rejectLen), PQCP_SUCCESS);
+    ASSERT_TRUE(memcmp(rejectKey, sharedKey, sharedLen) != 0);
+
+    // the honest and the changed ciphertext decapsulate alike on every context, with or without the cache
+    ASSERT_TRUE(TEST_PolarLacDecapsMatch(ctx, cipher, cipherLen, sharedKey));
+    ASSERT_TRUE(TEST_PolarLacDecapsMatch(prvCtx, cipher, cipherLen, sharedKey));
+    ASSERT_TRUE(TEST_PolarLacDecapsMatch(prvCtx, badCipher, cipherLen, rejectKey));
+    dupCtx = PQCP_LAC2_DupCtx(ctx);
+    ASSERT_TRUE(dupCtx != NULL && dupCtx->skNttReady);
+    ASSERT_TRUE(TEST_PolarLacDecapsMatch(dupCtx, cipher, cipherLen, sharedKey));
+    ASSERT_TRUE(TEST_PolarLacDecapsMatch(dupCtx, badCipher, cipherLen, rejectKey));
+    prvCtx->skNttReady = false;
+    ASSERT_TRUE(TEST_PolarLacDecapsMatch(prvCtx, cipher, cipherLen, sharedKey));
+    ASSERT_TRUE(TEST_PolarLacDecapsMatch(prvCtx, badCipher, cipherLen, rejectKey));
+    dupPrvCtx = PQCP_LAC2_DupCtx(prvCtx);
+    ASSERT_TRUE(dupPrvCtx != NULL && !dupPrvCtx->skNttReady);
+    ASSERT_TRUE(TEST_PolarLacDecapsMatch(dupPrvCtx, cipher, cipherLen, sharedKey));
+    ASSERT_TRUE(TEST_PolarLacDecapsMatch(dupPrvCtx, badCipher, cipherLen, rejectKey));
+
+EXIT:
+    PQCP_LAC2_FreeCtx(ctx);
+    PQCP_LAC2_FreeCtx(prvCtx);
+    PQCP_LAC2_FreeCtx(dupCtx);
+    PQCP_LAC2_FreeCtx(dupPrvCtx);
+    CRYPT_EAL_SetRandCallBack(NULL);
+    return;
+#else
+    SKIP_TEST();
+    (void)algId;
+#endif
+}
+/* END_CASE */
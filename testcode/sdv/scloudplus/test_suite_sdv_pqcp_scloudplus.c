@@ -45,6 +45,44 @@ static int32_t TEST_ScloudPlusRandom(uint8_t *randNum, uint32_t randLen)
     }
     return 0;
 }
+
+/* 随机数生成器始终失败，用于验证确定性种子模式不消耗随机数 */
+static int32_t TEST_ScloudPlusRandomFail(uint8_t *randNum, uint32_t randLen)
+{
+    (void)randNum;
+    (void)randLen;
+    return -1;
+}
+
+/* 逆序串行执行各任务，用于验证并行结果与任务执行顺序无关 */
+static int32_t TEST_ScloudPlusReverseFor(void *pool, uint32_t taskNum, PQCP_ParallelTask task, void *arg)
+{
+    (void)pool;
+    for (uint32_t i = taskNum; i > 0; i--) {
+        task(arg, i - 1);
+    }
+    return PQCP_SUCCESS;
+}
+
+/* 在固定随机数下生成密钥并封装一次，输出pk、sk、密文与共享密钥 */
+static int32_t TEST_ScloudPlusGenEncaps(SCLOUDPLUS_Ctx *ctx, BSL_Param *pub, BSL_Param *prv, uint8_t *cipher,
+    uint32_t *cipherLen, uint8_t *sharedKey, uint32_t *sharedLen)
+{
+    gScloudPlusRandNum = 0;
+    int32_t ret = PQCP_SCLOUDPLUS_Gen(ctx);
+    if (ret != PQCP_SUCCESS) {
+        return ret;
+    }
+    ret = PQCP_SCLOUDPLUS_GetPubKey(ctx, pub);
+    if (ret != PQCP_SUCCESS) {
+        return ret;
+    }
+    ret = PQCP_SCLOUDPLUS_GetPrvKey(ctx, prv);
+    if (ret != PQCP_SUCCESS) {
+        return ret;
+    }
+    return PQCP_SCLOUDPLUS_Encaps(ctx, cipher, cipherLen, sharedKey, sharedLen);
+}
 #endif
 /* @
 * @test  SDV_CRYPTO_PQCP_SCLOUDPLUS_KEYGEN_API_TC001
@@ -520,6 +558,810 @@ EXIT:
 /* END_CASE */
 
 
+/* @
+* @test  SDV_CRYPTO_PQCP_SCLOUDPLUS_INVALID_PRVKEY_TC001
+* @spec  -
+* @title  PQCP SCloud+ Malformed Secret Matrix Test
+* @precon  nan
+* @brief  1. Generate key pair and encaps
+*         2. Corrupt the packed secret matrix S in the private key and set it to another context
+*         3. Decaps with the corrupted key
+* @expect  Decaps returns PQCP_SCLOUDPLUS_INVALID_ARG since S is no longer a valid ternary matrix
+* @prior  nan
+* @auto  FALSE
+@ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_PQCP_SCLOUDPLUS_INVALID_PRVKEY_TC001(int bits)
+{
+#ifdef PQCP_SCLOUDPLUS
+    TestMemInit();
+    TestRandInit();
+    CRYPT_EAL_PkeyCtx *ctx = NULL;
+    CRYPT_EAL_PkeyCtx *ctx2 = NULL;
+    uint8_t *prvData = NULL;
+    uint8_t *cipher = NULL;
+    uint8_t *sharedKey = NULL;
+
+    ctx = CRYPT_EAL_ProviderPkeyNewCtx(NULL, PQCP_PKEY_SCLOUDPLUS, CRYPT_EAL_PKEY_KEM_OPERATE, "provider=pqcp");
+    ctx2 = CRYPT_EAL_ProviderPkeyNewCtx(NULL, PQCP_PKEY_SCLOUDPLUS, CRYPT_EAL_PKEY_KEM_OPERATE, "provider=pqcp");
+    ASSERT_TRUE(ctx != NULL);
+    ASSERT_TRUE(ctx2 != NULL);
+
+    uint32_t val = (uint32_t)bits;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx2, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyGen(ctx), PQCP_SUCCESS);
+
+    uint32_t prvLen = 0;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_GET_PRVKEY_LEN, &prvLen, sizeof(prvLen)), PQCP_SUCCESS);
+    uint32_t cipherLen = 0;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_GET_CIPHERTEXT_LEN, &cipherLen, sizeof(cipherLen)), PQCP_SUCCESS);
+    uint32_t sharedLen = 0;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_GET_SHARED_KEY_LEN, &sharedLen, sizeof(sharedLen)), PQCP_SUCCESS);
+    prvData = BSL_SAL_Malloc(prvLen);
+    ASSERT_TRUE(prvData != NULL);
+    cipher = BSL_SAL_Malloc(cipherLen);
+    ASSERT_TRUE(cipher != NULL);
+    sharedKey = BSL_SAL_Malloc(sharedLen);
+    ASSERT_TRUE(sharedKey != NULL);
+
+    BSL_Param prv[2] = {
+        {PQCP_PARAM_SCLOUDPLUS_PRVKEY, BSL_PARAM_TYPE_OCTETS, prvData, prvLen, 0},
+        BSL_PARAM_END
+    };
+    ASSERT_EQ(CRYPT_EAL_PkeyGetPrvEx(ctx, prv), PQCP_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyEncapsInit(ctx, NULL), PQCP_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyEncaps(ctx, cipher, &cipherLen, sharedKey, &sharedLen), PQCP_SUCCESS);
+
+    // 0b10 encodes -2, which never occurs in a sampled secret matrix
+    prvData[0] = 0xAA;
+    ASSERT_EQ(CRYPT_EAL_PkeySetPrvEx(ctx2, prv), PQCP_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyDecapsInit(ctx2, NULL), PQCP_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyDecaps(ctx2, cipher, cipherLen, sharedKey, &sharedLen), PQCP_SCLOUDPLUS_INVALID_ARG);
+
+EXIT:
+    CRYPT_EAL_PkeyFreeCtx(ctx);
+    CRYPT_EAL_PkeyFreeCtx(ctx2);
+    BSL_SAL_Free(prvData);
+    BSL_SAL_Free(cipher);
+    BSL_SAL_Free(sharedKey);
+    TestRandDeInit();
+    return;
+#else
+    SKIP_TEST();
+    (void)bits;
+#endif
+}
+/* END_CASE */
+
+/* @
+* @test  SDV_CRYPTO_PQCP_SCLOUDPLUS_MATRIX_A_CACHE_TC001
+* @spec  -
+* @title  PQCP SCloud+ Matrix A Cache Test
+* @precon  nan
+* @brief  1. Generate key pair and enable the matrix A cache with the given budget
+*         2. Encaps several times on the same context so later calls hit the cache
+*         3. Decaps with a duplicated context and compare shared keys
+* @expect  Shared keys match for every budget
+* @prior  nan
+* @auto  FALSE
+@ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_PQCP_SCLOUDPLUS_MATRIX_A_CACHE_TC001(int bits, int budget)
+{
+#ifdef PQCP_SCLOUDPLUS
+    TestMemInit();
+    TestRandInit();
+    CRYPT_EAL_PkeyCtx *ctx = NULL;
+    CRYPT_EAL_PkeyCtx *dupCtx = NULL;
+    uint8_t *cipher = NULL;
+    uint8_t *sharedKey = NULL;
+    uint8_t *decSharedKey = NULL;
+
+    ctx = CRYPT_EAL_ProviderPkeyNewCtx(NULL, PQCP_PKEY_SCLOUDPLUS, CRYPT_EAL_PKEY_KEM_OPERATE, "provider=pqcp");
+    ASSERT_TRUE(ctx != NULL);
+
+    uint32_t val = (uint32_t)bits;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    uint32_t cacheBudget = (uint32_t)budget;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, PQCP_SCLOUDPLUS_SET_MATRIX_A_CACHE, NULL, sizeof(cacheBudget)),
+        PQCP_NULL_INPUT);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, PQCP_SCLOUDPLUS_SET_MATRIX_A_CACHE, &cacheBudget, sizeof(cacheBudget)),
+        PQCP_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyGen(ctx), PQCP_SUCCESS);
+
+    uint32_t cipherLen = 0;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_GET_CIPHERTEXT_LEN, &cipherLen, sizeof(cipherLen)), PQCP_SUCCESS);
+    uint32_t sharedLen = 0;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(ctx, CRYPT_CTRL_GET_SHARED_KEY_LEN, &sharedLen, sizeof(sharedLen)), PQCP_SUCCESS);
+    cipher = BSL_SAL_Malloc(cipherLen);
+    ASSERT_TRUE(cipher != NULL);
+    sharedKey = BSL_SAL_Malloc(sharedLen);
+    ASSERT_TRUE(sharedKey != NULL);
+    decSharedKey = BSL_SAL_Malloc(sharedLen);
+    ASSERT_TRUE(decSharedKey != NULL);
+
+    ASSERT_EQ(CRYPT_EAL_PkeyEncapsInit(ctx, NULL), PQCP_SUCCESS);
+    for (int i = 0; i < 3; i++) {
+        uint32_t ctLen = cipherLen;
+        uint32_t ssLen = sharedLen;
+        uint32_t decSsLen = sharedLen;
+        ASSERT_EQ(CRYPT_EAL_PkeyEncaps(ctx, cipher, &ctLen, sharedKey, &ssLen), PQCP_SUCCESS);
+        dupCtx = CRYPT_EAL_PkeyDupCtx(ctx);
+        ASSERT_TRUE(dupCtx != NULL);
+        ASSERT_EQ(CRYPT_EAL_PkeyDecapsInit(dupCtx, NULL), PQCP_SUCCESS);
+        ASSERT_EQ(CRYPT_EAL_PkeyDecaps(dupCtx, cipher, ctLen, decSharedKey, &decSsLen), PQCP_SUCCESS);
+        ASSERT_COMPARE("compare ss", sharedKey, ssLen, decSharedKey, decSsLen);
+        CRYPT_EAL_PkeyFreeCtx(dupCtx);
+        dupCtx = NULL;
+    }
+
+EXIT:
+    CRYPT_EAL_PkeyFreeCtx(ctx);
+    CRYPT_EAL_PkeyFreeCtx(dupCtx);
+    BSL_SAL_Free(cipher);
+    BSL_SAL_Free(sharedKey);
+    BSL_SAL_Free(decSharedKey);
+    TestRandDeInit();
+    return;
+#else
+    SKIP_TEST();
+    (void)bits;
+    (void)budget;
+#endif
+}
+/* END_CASE */
+
+
+/* @
+* @test  SDV_CRYPTO_PQCP_SCLOUDPLUS_PREPARED_KEY_TC001
+* @spec  -
+* @title  PQCP SCloud+ Prepared Key Replacement Test
+* @precon  nan
+* @brief  1. Generate two key pairs
+*         2. Encaps/Decaps with the first keys set on separate contexts
+*         3. Replace the public and private keys with the second pair on the same contexts
+*         4. Encaps/Decaps again and compare shared keys
+* @expect  Shared keys match after the keys are replaced
+* @prior  nan
+* @auto  FALSE
+@ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_PQCP_SCLOUDPLUS_PREPARED_KEY_TC001(int bits)
+{
+#ifdef PQCP_SCLOUDPLUS
+    TestMemInit();
+    TestRandInit();
+    CRYPT_EAL_PkeyCtx *keyCtx[2] = {NULL, NULL};
+    CRYPT_EAL_PkeyCtx *enCtx = NULL;
+    CRYPT_EAL_PkeyCtx *deCtx = NULL;
+    uint8_t *pubData = NULL;
+    uint8_t *prvData = NULL;
+    uint8_t *cipher = NULL;
+    uint8_t *sharedKey = NULL;
+    uint8_t *decSharedKey = NULL;
+
+    uint32_t val = (uint32_t)bits;
+    for (int i = 0; i < 2; i++) {
+        keyCtx[i] = CRYPT_EAL_ProviderPkeyNewCtx(NULL, PQCP_PKEY_SCLOUDPLUS, CRYPT_EAL_PKEY_KEM_OPERATE,
+            "provider=pqcp");
+        ASSERT_TRUE(keyCtx[i] != NULL);
+        ASSERT_EQ(CRYPT_EAL_PkeyCtrl(keyCtx[i], CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+        ASSERT_EQ(CRYPT_EAL_PkeyGen(keyCtx[i]), PQCP_SUCCESS);
+    }
+    enCtx = CRYPT_EAL_ProviderPkeyNewCtx(NULL, PQCP_PKEY_SCLOUDPLUS, CRYPT_EAL_PKEY_KEM_OPERATE, "provider=pqcp");
+    deCtx = CRYPT_EAL_ProviderPkeyNewCtx(NULL, PQCP_PKEY_SCLOUDPLUS, CRYPT_EAL_PKEY_KEM_OPERATE, "provider=pqcp");
+    ASSERT_TRUE(enCtx != NULL);
+    ASSERT_TRUE(deCtx != NULL);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(enCtx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(deCtx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+
+    uint32_t pubLen = 0;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(enCtx, CRYPT_CTRL_GET_PUBKEY_LEN, &pubLen, sizeof(pubLen)), PQCP_SUCCESS);
+    uint32_t prvLen = 0;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(deCtx, CRYPT_CTRL_GET_PRVKEY_LEN, &prvLen, sizeof(prvLen)), PQCP_SUCCESS);
+    uint32_t cipherLen = 0;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(enCtx, CRYPT_CTRL_GET_CIPHERTEXT_LEN, &cipherLen, sizeof(cipherLen)), PQCP_SUCCESS);
+    uint32_t sharedLen = 0;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(enCtx, CRYPT_CTRL_GET_SHARED_KEY_LEN, &sharedLen, sizeof(sharedLen)), PQCP_SUCCESS);
+    pubData = BSL_SAL_Malloc(pubLen);
+    ASSERT_TRUE(pubData != NULL);
+    prvData = BSL_SAL_Malloc(prvLen);
+    ASSERT_TRUE(prvData != NULL);
+    cipher = BSL_SAL_Malloc(cipherLen);
+    ASSERT_TRUE(cipher != NULL);
+    sharedKey = BSL_SAL_Malloc(sharedLen);
+    ASSERT_TRUE(sharedKey != NULL);
+    decSharedKey = BSL_SAL_Malloc(sharedLen);
+    ASSERT_TRUE(decSharedKey != NULL);
+
+    BSL_Param pub[2] = {
+        {PQCP_PARAM_SCLOUDPLUS_PUBKEY, BSL_PARAM_TYPE_OCTETS, pubData, pubLen, 0},
+        BSL_PARAM_END
+    };
+    BSL_Param prv[2] = {
+        {PQCP_PARAM_SCLOUDPLUS_PRVKEY, BSL_PARAM_TYPE_OCTETS, prvData, prvLen, 0},
+        BSL_PARAM_END
+    };
+    ASSERT_EQ(CRYPT_EAL_PkeyEncapsInit(enCtx, NULL), PQCP_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyDecapsInit(deCtx, NULL), PQCP_SUCCESS);
+    for (int i = 0; i < 2; i++) {
+        ASSERT_EQ(CRYPT_EAL_PkeyGetPubEx(keyCtx[i], pub), PQCP_SUCCESS);
+        ASSERT_EQ(CRYPT_EAL_PkeySetPubEx(enCtx, pub), PQCP_SUCCESS);
+        ASSERT_EQ(CRYPT_EAL_PkeyGetPrvEx(keyCtx[i], prv), PQCP_SUCCESS);
+        ASSERT_EQ(CRYPT_EAL_PkeySetPrvEx(deCtx, prv), PQCP_SUCCESS);
+
+        uint32_t ctLen = cipherLen;
+        uint32_t ssLen = sharedLen;
+        uint32_t decSsLen = sharedLen;
+        ASSERT_EQ(CRYPT_EAL_PkeyEncaps(enCtx, cipher, &ctLen, sharedKey, &ssLen), PQCP_SUCCESS);
+        ASSERT_EQ(CRYPT_EAL_PkeyDecaps(deCtx, cipher, ctLen, decSharedKey, &decSsLen), PQCP_SUCCESS);
+        ASSERT_COMPARE("compare ss", sharedKey, ssLen, decSharedKey, decSsLen);
+    }
+
+EXIT:
+    CRYPT_EAL_PkeyFreeCtx(keyCtx[0]);
+    CRYPT_EAL_PkeyFreeCtx(keyCtx[1]);
+    CRYPT_EAL_PkeyFreeCtx(enCtx);
+    CRYPT_EAL_PkeyFreeCtx(deCtx);
+    BSL_SAL_Free(pubData);
+    BSL_SAL_Free(prvData);
+    BSL_SAL_Free(cipher);
+    BSL_SAL_Free(sharedKey);
+    BSL_SAL_Free(decSharedKey);
+    TestRandDeInit();
+    return;
+#else
+    SKIP_TEST();
+    (void)bits;
+#endif
+}
+/* END_CASE */
+
+/* @
+* @test  SDV_CRYPTO_PQCP_SCLOUDPLUS_ENCAPS_BATCH_TC001
+* @spec  -
+* @title  PQCP SCloud+ Batch Encapsulation Test
+* @precon  nan
+* @brief  1. Generate a key pair and set the public key on a second context
+*         2. Batch encapsulate num ciphertexts on the second context
+*         3. Decapsulate every ciphertext with the key pair and compare shared keys
+*         4. Batch encapsulate with a short ciphertext buffer
+* @expect  1-3. Shared keys match
+*          4. PQCP_INVALID_ARG
+* @prior  nan
+* @auto  FALSE
+@ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_PQCP_SCLOUDPLUS_ENCAPS_BATCH_TC001(int bits, int num)
+{
+#ifdef PQCP_SCLOUDPLUS
+    TestMemInit();
+    TestRandInit();
+    SCLOUDPLUS_Ctx *keyCtx = NULL;
+    SCLOUDPLUS_Ctx *enCtx = NULL;
+    uint8_t *pubData = NULL;
+    uint8_t *cipher = NULL;
+    uint8_t *sharedKey = NULL;
+    uint8_t decSharedKey[32];
+
+    uint32_t val = (uint32_t)bits;
+    keyCtx = PQCP_SCLOUDPLUS_NewCtx();
+    ASSERT_TRUE(keyCtx != NULL);
+    enCtx = PQCP_SCLOUDPLUS_NewCtx();
+    ASSERT_TRUE(enCtx != NULL);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(keyCtx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(enCtx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Gen(keyCtx), PQCP_SUCCESS);
+
+    uint32_t pubLen = 0;
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(keyCtx, CRYPT_CTRL_GET_PUBKEY_LEN, &pubLen, sizeof(pubLen)), PQCP_SUCCESS);
+    uint32_t cipherLen = 0;
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(keyCtx, CRYPT_CTRL_GET_CIPHERTEXT_LEN, &cipherLen, sizeof(cipherLen)), PQCP_SUCCESS);
+    uint32_t sharedLen = 0;
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(keyCtx, CRYPT_CTRL_GET_SHARED_KEY_LEN, &sharedLen, sizeof(sharedLen)), PQCP_SUCCESS);
+    pubData = BSL_SAL_Malloc(pubLen);
+    ASSERT_TRUE(pubData != NULL);
+    cipher = BSL_SAL_Malloc(cipherLen * num);
+    ASSERT_TRUE(cipher != NULL);
+    sharedKey = BSL_SAL_Malloc(sharedLen * num);
+    ASSERT_TRUE(sharedKey != NULL);
+
+    BSL_Param pub[2] = {
+        {PQCP_PARAM_SCLOUDPLUS_PUBKEY, BSL_PARAM_TYPE_OCTETS, pubData, pubLen, 0},
+        BSL_PARAM_END
+    };
+    ASSERT_EQ(PQCP_SCLOUDPLUS_GetPubKey(keyCtx, pub), PQCP_SUCCESS);
+    pub[0].valueLen = pub[0].useLen;
+    ASSERT_EQ(PQCP_SCLOUDPLUS_SetPubKey(enCtx, pub), PQCP_SUCCESS);
+
+    uint32_t ctLen = cipherLen * num;
+    uint32_t ssLen = sharedLen * num;
+    ASSERT_EQ(PQCP_SCLOUDPLUS_EncapsBatch(enCtx, num, cipher, &ctLen, sharedKey, &ssLen), PQCP_SUCCESS);
+    ASSERT_EQ(ctLen, cipherLen * num);
+    ASSERT_EQ(ssLen, sharedLen * num);
+    for (int i = 0; i < num; i++) {
+        uint32_t decSsLen = sizeof(decSharedKey);
+        ASSERT_EQ(PQCP_SCLOUDPLUS_Decaps(keyCtx, cipher + i * cipherLen, cipherLen, decSharedKey, &decSsLen),
+            PQCP_SUCCESS);
+        ASSERT_COMPARE("compare ss", sharedKey + i * sharedLen, sharedLen, decSharedKey, decSsLen);
+    }
+
+    ctLen = cipherLen * num - 1;
+    ssLen = sharedLen * num;
+    ASSERT_EQ(PQCP_SCLOUDPLUS_EncapsBatch(enCtx, num, cipher, &ctLen, sharedKey, &ssLen), PQCP_INVALID_ARG);
+
+EXIT:
+    PQCP_SCLOUDPLUS_FreeCtx(keyCtx);
+    PQCP_SCLOUDPLUS_FreeCtx(enCtx);
+    BSL_SAL_Free(pubData);
+    BSL_SAL_Free(cipher);
+    BSL_SAL_Free(sharedKey);
+    TestRandDeInit();
+    return;
+#else
+    SKIP_TEST();
+    (void)bits;
+    (void)num;
+#endif
+}
+/* END_CASE */
+
+/* @
+* @test  SDV_CRYPTO_PQCP_SCLOUDPLUS_PARALLEL_TC001
+* @spec  -
+* @title  PQCP SCloud+ parallel keygen and encaps match the serial result
+* @precon  nan
+* @brief  1. Stub Random Function with fixed values
+*         2. KeyGen and Encaps on a serial context
+*         3. Set PQCP_SCLOUDPLUS_SET_PARALLEL with taskNum tasks run in reverse order, KeyGen and Encaps again
+*         4. Decapsulate the parallel ciphertext
+*         5. Set PQCP_SCLOUDPLUS_SET_PARALLEL with an invalid task number
+* @expect  1-4. pk, sk, ciphertext and shared key equal the serial ones
+*          5. PQCP_SCLOUDPLUS_INVALID_ARG
+* @prior  nan
+* @auto  FALSE
+@ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_PQCP_SCLOUDPLUS_PARALLEL_TC001(int bits, int taskNum)
+{
+#ifdef PQCP_SCLOUDPLUS
+    TestMemInit();
+    SCLOUDPLUS_Ctx *serCtx = NULL;
+    SCLOUDPLUS_Ctx *parCtx = NULL;
+    uint8_t *buf = NULL;
+    uint8_t decSharedKey[32];
+    CRYPT_EAL_SetRandCallBack(TEST_ScloudPlusRandom);
+    for (uint32_t i = 0; i < sizeof(gScloudPlusRandBuf); i++) {
+        gScloudPlusRandBuf[i / 64][i % 64] = (uint8_t)(i * 7 + 1);
+    }
+
+    uint32_t val = (uint32_t)bits;
+    serCtx = PQCP_SCLOUDPLUS_NewCtx();
+    ASSERT_TRUE(serCtx != NULL);
+    parCtx = PQCP_SCLOUDPLUS_NewCtx();
+    ASSERT_TRUE(parCtx != NULL);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(serCtx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(parCtx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    PQCP_ParallelCfg cfg = {TEST_ScloudPlusReverseFor, NULL, (uint32_t)taskNum};
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(parCtx, PQCP_SCLOUDPLUS_SET_PARALLEL, &cfg, sizeof(cfg)), PQCP_SUCCESS);
+
+    uint32_t pubLen = 0;
+    uint32_t prvLen = 0;
+    uint32_t cipherLen = 0;
+    uint32_t sharedLen = 0;
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(serCtx, CRYPT_CTRL_GET_PUBKEY_LEN, &pubLen, sizeof(pubLen)), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(serCtx, CRYPT_CTRL_GET_PRVKEY_LEN, &prvLen, sizeof(prvLen)), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(serCtx, CRYPT_CTRL_GET_CIPHERTEXT_LEN, &cipherLen, sizeof(cipherLen)), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(serCtx, CRYPT_CTRL_GET_SHARED_KEY_LEN, &sharedLen, sizeof(sharedLen)), PQCP_SUCCESS);
+    uint32_t total = pubLen + prvLen + cipherLen + sharedLen;
+    buf = BSL_SAL_Calloc(2, total);
+    ASSERT_TRUE(buf != NULL);
+
+    uint8_t *out[2];
+    for (int i = 0; i < 2; i++) {
+        out[i] = buf + i * total;
+        BSL_Param pub[2] = {{PQCP_PARAM_SCLOUDPLUS_PUBKEY, BSL_PARAM_TYPE_OCTETS, out[i], pubLen, 0}, BSL_PARAM_END};
+        BSL_Param prv[2] = {
+            {PQCP_PARAM_SCLOUDPLUS_PRVKEY, BSL_PARAM_TYPE_OCTETS, out[i] + pubLen, prvLen, 0},
+            BSL_PARAM_END
+        };
+        uint32_t ctLen = cipherLen;
+        uint32_t ssLen = sharedLen;
+        ASSERT_EQ(TEST_ScloudPlusGenEncaps(i == 0 ? serCtx : parCtx, pub, prv, out[i] + pubLen + prvLen, &ctLen,
+            out[i] + pubLen + prvLen + cipherLen, &ssLen), PQCP_SUCCESS);
+    }
+    ASSERT_COMPARE("compare pk", out[0], pubLen, out[1], pubLen);
+    ASSERT_COMPARE("compare sk", out[0] + pubLen, prvLen, out[1] + pubLen, prvLen);
+    ASSERT_COMPARE("compare ct", out[0] + pubLen + prvLen, cipherLen, out[1] + pubLen + prvLen, cipherLen);
+    ASSERT_COMPARE("compare ss", out[0] + pubLen + prvLen + cipherLen, sharedLen,
+        out[1] + pubLen + prvLen + cipherLen, sharedLen);
+
+    uint32_t decSsLen = sizeof(decSharedKey);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Decaps(parCtx, out[1] + pubLen + prvLen, cipherLen, decSharedKey, &decSsLen),
+        PQCP_SUCCESS);
+    ASSERT_COMPARE("compare dec ss", decSharedKey, decSsLen, out[0] + pubLen + prvLen + cipherLen, sharedLen);
+
+    cfg.taskNum = 0;
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(parCtx, PQCP_SCLOUDPLUS_SET_PARALLEL, &cfg, sizeof(cfg)),
+        PQCP_SCLOUDPLUS_INVALID_ARG);
+EXIT:
+    PQCP_SCLOUDPLUS_FreeCtx(serCtx);
+    PQCP_SCLOUDPLUS_FreeCtx(parCtx);
+    BSL_SAL_Free(buf);
+    TestRandDeInit();
+    return;
+#else
+    SKIP_TEST();
+    (void)bits;
+    (void)taskNum;
+#endif
+}
+/* END_CASE */
+
+/* @
+* @test  SDV_CRYPTO_PQCP_SCLOUDPLUS_DECAPS_REJECT_TC001
+* @spec  -
+* @title  PQCP SCloud+ decapsulation of a modified ciphertext
+* @precon  nan
+* @brief  1. Create context, generate key pair and encapsulate
+*         2. Flip one bit at the start, middle and last byte of the ciphertext and decapsulate twice
+*         3. Restore the ciphertext and decapsulate
+* @expect  1. success
+*          2. Decaps succeeds with a shared key that differs from the encapsulated one and is the same both times
+*          3. Shared key equals the encapsulated one
+* @prior  nan
+* @auto  FALSE
+@ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_PQCP_SCLOUDPLUS_DECAPS_REJECT_TC001(int bits)
+{
+#ifdef PQCP_SCLOUDPLUS
+    TestMemInit();
+    TestRandInit();
+    SCLOUDPLUS_Ctx *ctx = NULL;
+    uint8_t *cipher = NULL;
+    uint8_t sharedKey[32];
+    uint8_t decSharedKey[32];
+    uint8_t rejSharedKey[32];
+
+    uint32_t val = (uint32_t)bits;
+    ctx = PQCP_SCLOUDPLUS_NewCtx();
+    ASSERT_TRUE(ctx != NULL);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Gen(ctx), PQCP_SUCCESS);
+    uint32_t cipherLen = 0;
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, CRYPT_CTRL_GET_CIPHERTEXT_LEN, &cipherLen, sizeof(cipherLen)), PQCP_SUCCESS);
+    cipher = BSL_SAL_Malloc(cipherLen);
+    ASSERT_TRUE(cipher != NULL);
+    uint32_t ctLen = cipherLen;
+    uint32_t ssLen = sizeof(sharedKey);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Encaps(ctx, cipher, &ctLen, sharedKey, &ssLen), PQCP_SUCCESS);
+
+    uint32_t offsets[] = {0, cipherLen / 2, cipherLen - 1};
+    for (uint32_t i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++) {
+        cipher[offsets[i]] ^= 0x01;
+        uint32_t decSsLen = sizeof(decSharedKey);
+        ASSERT_EQ(PQCP_SCLOUDPLUS_Decaps(ctx, cipher, cipherLen, decSharedKey, &decSsLen), PQCP_SUCCESS);
+        ASSERT_TRUE(memcmp(decSharedKey, sharedKey, decSsLen) != 0);
+        uint32_t rejSsLen = sizeof(rejSharedKey);
+        ASSERT_EQ(PQCP_SCLOUDPLUS_Decaps(ctx, cipher, cipherLen, rejSharedKey, &rejSsLen), PQCP_SUCCESS);
+        ASSERT_COMPARE("compare reject ss", decSharedKey, decSsLen, rejSharedKey, rejSsLen);
+        cipher[offsets[i]] ^= 0x01;
+    }
+    uint32_t decSsLen = sizeof(decSharedKey);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Decaps(ctx, cipher, cipherLen, decSharedKey, &decSsLen), PQCP_SUCCESS);
+    ASSERT_COMPARE("compare ss", sharedKey, decSsLen, decSharedKey, decSsLen);
+
+EXIT:
+    PQCP_SCLOUDPLUS_FreeCtx(ctx);
+    BSL_SAL_Free(cipher);
+    TestRandDeInit();
+    return;
+#else
+    SKIP_TEST();
+    (void)bits;
+#endif
+}
+/* END_CASE */
+
+/* @
+* @test  SDV_CRYPTO_PQCP_SCLOUDPLUS_DETERMINISTIC_TC001
+* @spec  -
+* @title  PQCP SCloud+ keygen and encaps with caller-supplied seeds
+* @precon  nan
+* @brief  1. Set seeds with invalid length
+*         2. Stub a failing random function, set the same keygen seed on two contexts and generate key pairs
+*         3. Generate again without a seed
+*         4. Encaps twice with the same encaps seed, then once without a seed
+*         5. Decaps the seeded ciphertext
+* @expect  1. PQCP_NULL_INPUT
+*          2. success, both key pairs are identical
+*          3. failure, the seed is used only once
+*          4. identical ciphertexts and shared keys, encaps without a seed fails
+*          5. shared key matches
+* @prior  nan
+* @auto  FALSE
+@ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_PQCP_SCLOUDPLUS_DETERMINISTIC_TC001(int bits)
+{
+#ifdef PQCP_SCLOUDPLUS
+    TestMemInit();
+    SCLOUDPLUS_Ctx *ctx = NULL;
+    SCLOUDPLUS_Ctx *ctx2 = NULL;
+    uint8_t *cipher = NULL;
+    uint8_t keygenSeed[64];
+    uint8_t encapsSeed[32];
+    uint8_t sharedKey[2][32];
+    uint8_t decSharedKey[32];
+    for (uint32_t i = 0; i < sizeof(keygenSeed); i++) {
+        keygenSeed[i] = (uint8_t)(i * 7 + 1);
+    }
+    for (uint32_t i = 0; i < sizeof(encapsSeed); i++) {
+        encapsSeed[i] = (uint8_t)(i * 13 + 5);
+    }
+
+    uint32_t val = (uint32_t)bits;
+    ctx = PQCP_SCLOUDPLUS_NewCtx();
+    ctx2 = PQCP_SCLOUDPLUS_NewCtx();
+    ASSERT_TRUE(ctx != NULL && ctx2 != NULL);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, PQCP_SCLOUDPLUS_SET_ENCAPS_SEED, encapsSeed, sizeof(encapsSeed)),
+        PQCP_NULL_INPUT);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx2, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    uint32_t ssLen = 0;
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, CRYPT_CTRL_GET_SHARED_KEY_LEN, &ssLen, sizeof(ssLen)), PQCP_SUCCESS);
+    uint32_t cipherLen = 0;
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, CRYPT_CTRL_GET_CIPHERTEXT_LEN, &cipherLen, sizeof(cipherLen)), PQCP_SUCCESS);
+    uint32_t pubLen = 0;
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, CRYPT_CTRL_GET_PUBKEY_LEN, &pubLen, sizeof(pubLen)), PQCP_SUCCESS);
+    uint32_t prvLen = 0;
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, CRYPT_CTRL_GET_PRVKEY_LEN, &prvLen, sizeof(prvLen)), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, PQCP_SCLOUDPLUS_SET_KEYGEN_SEED, keygenSeed, sizeof(keygenSeed) - 1),
+        PQCP_NULL_INPUT);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, PQCP_SCLOUDPLUS_SET_KEYGEN_SEED, NULL, sizeof(keygenSeed)), PQCP_NULL_INPUT);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, PQCP_SCLOUDPLUS_SET_ENCAPS_SEED, encapsSeed, ssLen + 1), PQCP_NULL_INPUT);
+
+    CRYPT_EAL_SetRandCallBack(TEST_ScloudPlusRandomFail);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, PQCP_SCLOUDPLUS_SET_KEYGEN_SEED, keygenSeed, sizeof(keygenSeed)),
+        PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx2, PQCP_SCLOUDPLUS_SET_KEYGEN_SEED, keygenSeed, sizeof(keygenSeed)),
+        PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Gen(ctx), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Gen(ctx2), PQCP_SUCCESS);
+    ASSERT_COMPARE("compare pk", ctx->publicKey, pubLen, ctx2->publicKey, pubLen);
+    ASSERT_COMPARE("compare sk", ctx->privateKey, prvLen, ctx2->privateKey, prvLen);
+    ASSERT_TRUE(PQCP_SCLOUDPLUS_Gen(ctx2) != PQCP_SUCCESS);
+
+    cipher = BSL_SAL_Malloc(cipherLen * 2);
+    ASSERT_TRUE(cipher != NULL);
+    for (uint32_t i = 0; i < 2; i++) {
+        uint32_t ctLen = cipherLen;
+        uint32_t encSsLen = sizeof(sharedKey[i]);
+        ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, PQCP_SCLOUDPLUS_SET_ENCAPS_SEED, encapsSeed, ssLen), PQCP_SUCCESS);
+        ASSERT_EQ(PQCP_SCLOUDPLUS_Encaps(ctx, cipher + i * cipherLen, &ctLen, sharedKey[i], &encSsLen), PQCP_SUCCESS);
+    }
+    ASSERT_COMPARE("compare ct", cipher, cipherLen, cipher + cipherLen, cipherLen);
+    ASSERT_COMPARE("compare ss", sharedKey[0], ssLen, sharedKey[1], ssLen);
+    uint32_t ctLen = cipherLen;
+    uint32_t encSsLen = sizeof(sharedKey[1]);
+    ASSERT_TRUE(PQCP_SCLOUDPLUS_Encaps(ctx, cipher + cipherLen, &ctLen, sharedKey[1], &encSsLen) != PQCP_SUCCESS);
+    uint32_t decSsLen = sizeof(decSharedKey);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Decaps(ctx, cipher, cipherLen, decSharedKey, &decSsLen), PQCP_SUCCESS);
+    ASSERT_COMPARE("compare dec ss", sharedKey[0], ssLen, decSharedKey, decSsLen);
+
+EXIT:
+    PQCP_SCLOUDPLUS_FreeCtx(ctx);
+    PQCP_SCLOUDPLUS_FreeCtx(ctx2);
+    BSL_SAL_Free(cipher);
+    TestRandDeInit();
+    return;
+#else
+    SKIP_TEST();
+    (void)bits;
+#endif
+}
+/* END_CASE */
+
+/* @
+* @test  SDV_CRYPTO_PQCP_SCLOUDPLUS_ENCAPS_POOL_TC001
+* @spec  -
+* @title  PQCP SCloud+ encapsulation from a precomputed ciphertext pool
+* @precon  nan
+* @brief  1. Fill the pool before it is configured, and configure an oversized pool
+*         2. Configure the pool with the given capacity and fill it in two steps
+*         3. Encaps with a longer shared key buffer
+*         4. Encaps capacity times, then once more, and decaps every ciphertext
+*         5. Refill the pool and generate a new key pair
+* @expect  1. failure
+*          2. the pool holds capacity entries
+*          3. the pool is not used
+*          4. the pool drains one entry per call, all shared keys match and ciphertexts differ
+*          5. the pool is empty
+* @prior  nan
+* @auto  FALSE
+@ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_PQCP_SCLOUDPLUS_ENCAPS_POOL_TC001(int bits, int capacity)
+{
+#ifdef PQCP_SCLOUDPLUS
+    TestMemInit();
+    TestRandInit();
+    SCLOUDPLUS_Ctx *ctx = NULL;
+    uint8_t *cipher = NULL;
+    uint8_t sharedKey[64];
+    uint8_t decSharedKey[32];
+
+    uint32_t val = (uint32_t)bits;
+    ctx = PQCP_SCLOUDPLUS_NewCtx();
+    ASSERT_TRUE(ctx != NULL);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Gen(ctx), PQCP_SUCCESS);
+    uint32_t cipherLen = 0;
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, CRYPT_CTRL_GET_CIPHERTEXT_LEN, &cipherLen, sizeof(cipherLen)), PQCP_SUCCESS);
+    uint32_t ssLen = 0;
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, CRYPT_CTRL_GET_SHARED_KEY_LEN, &ssLen, sizeof(ssLen)), PQCP_SUCCESS);
+    cipher = BSL_SAL_Malloc(cipherLen * 2);
+    ASSERT_TRUE(cipher != NULL);
+
+    ASSERT_EQ(PQCP_SCLOUDPLUS_FillEncapsPool(ctx, 1), PQCP_INVALID_ARG);
+    uint32_t poolCap = 1 << 20;
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, PQCP_SCLOUDPLUS_SET_ENCAPS_POOL, &poolCap, sizeof(poolCap)),
+        PQCP_SCLOUDPLUS_INVALID_ARG);
+    poolCap = (uint32_t)capacity;
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, PQCP_SCLOUDPLUS_SET_ENCAPS_POOL, &poolCap, sizeof(poolCap)), PQCP_SUCCESS);
+    uint32_t poolNum = 0;
+    ASSERT_EQ(PQCP_SCLOUDPLUS_FillEncapsPool(ctx, 1), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, PQCP_SCLOUDPLUS_GET_ENCAPS_POOL_NUM, &poolNum, sizeof(poolNum)), PQCP_SUCCESS);
+    ASSERT_EQ(poolNum, 1);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_FillEncapsPool(ctx, 0xFFFFFFFF), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, PQCP_SCLOUDPLUS_GET_ENCAPS_POOL_NUM, &poolNum, sizeof(poolNum)), PQCP_SUCCESS);
+    ASSERT_EQ(poolNum, poolCap);
+
+    uint32_t ctLen = cipherLen;
+    uint32_t encSsLen = sizeof(sharedKey);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Encaps(ctx, cipher, &ctLen, sharedKey, &encSsLen), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, PQCP_SCLOUDPLUS_GET_ENCAPS_POOL_NUM, &poolNum, sizeof(poolNum)), PQCP_SUCCESS);
+    ASSERT_EQ(poolNum, poolCap);
+
+    for (uint32_t i = 0; i <= poolCap; i++) {
+        uint8_t *ct = cipher + (i % 2) * cipherLen;
+        ctLen = cipherLen;
+        encSsLen = ssLen;
+        ASSERT_EQ(PQCP_SCLOUDPLUS_Encaps(ctx, ct, &ctLen, sharedKey, &encSsLen), PQCP_SUCCESS);
+        ASSERT_EQ(ctLen, cipherLen);
+        ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, PQCP_SCLOUDPLUS_GET_ENCAPS_POOL_NUM, &poolNum, sizeof(poolNum)),
+            PQCP_SUCCESS);
+        ASSERT_EQ(poolNum, (i < poolCap) ? (poolCap - i - 1) : 0);
+        uint32_t decSsLen = sizeof(decSharedKey);
+        ASSERT_EQ(PQCP_SCLOUDPLUS_Decaps(ctx, ct, cipherLen, decSharedKey, &decSsLen), PQCP_SUCCESS);
+        ASSERT_COMPARE("compare ss", sharedKey, encSsLen, decSharedKey, decSsLen);
+        if (i > 0) {
+            ASSERT_TRUE(memcmp(cipher, cipher + cipherLen, cipherLen) != 0);
+        }
+    }
+
+    ASSERT_EQ(PQCP_SCLOUDPLUS_FillEncapsPool(ctx, 0xFFFFFFFF), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Gen(ctx), PQCP_SUCCESS);
+    ASSERT_EQ(PQCP_SCLOUDPLUS_Ctrl(ctx, PQCP_SCLOUDPLUS_GET_ENCAPS_POOL_NUM, &poolNum, sizeof(poolNum)), PQCP_SUCCESS);
+    ASSERT_EQ(poolNum, 0);
+
+EXIT:
+    PQCP_SCLOUDPLUS_FreeCtx(ctx);
+    BSL_SAL_Free(cipher);
+    TestRandDeInit();
+    return;
+#else
+    SKIP_TEST();
+    (void)bits;
+    (void)capacity;
+#endif
+}
+/* END_CASE */
+
+/* @
+* @test  SDV_CRYPTO_PQCP_SCLOUDPLUS_ENCAPS_POOL_CTRL_TC001
+* @spec  -
+* @title  PQCP SCloud+ precomputed ciphertext pool through CRYPT_EAL_PkeyCtrl
+* @precon  nan
+* @brief  1. Generate a key pair and import the public key into an encapsulation context
+*         2. Fill the pool before it is configured, and with an invalid argument
+*         3. Configure the pool with the given capacity and fill it in two steps
+*         4. Encaps capacity times, then once more, and decaps every ciphertext
+* @expect  1. success
+*          2. failure
+*          3. the pool holds capacity entries
+*          4. the pool drains one entry per call and all shared keys match
+* @prior  nan
+* @auto  FALSE
+@ */
+/* BEGIN_CASE */
+void SDV_CRYPTO_PQCP_SCLOUDPLUS_ENCAPS_POOL_CTRL_TC001(int bits, int capacity)
+{
+#ifdef PQCP_SCLOUDPLUS
+    TestMemInit();
+    TestRandInit();
+    CRYPT_EAL_PkeyCtx *enCtx = NULL;
+    CRYPT_EAL_PkeyCtx *deCtx = NULL;
+    uint8_t *cipher = NULL;
+    uint8_t *pubData = NULL;
+    uint8_t sharedKey[32];
+    uint8_t decSharedKey[32];
+    enCtx = CRYPT_EAL_ProviderPkeyNewCtx(NULL, PQCP_PKEY_SCLOUDPLUS, CRYPT_EAL_PKEY_KEM_OPERATE, "provider=pqcp");
+    deCtx = CRYPT_EAL_ProviderPkeyNewCtx(NULL, PQCP_PKEY_SCLOUDPLUS, CRYPT_EAL_PKEY_KEM_OPERATE, "provider=pqcp");
+    ASSERT_TRUE(enCtx != NULL);
+    ASSERT_TRUE(deCtx != NULL);
+
+    uint32_t val = (uint32_t)bits;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(enCtx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(deCtx, CRYPT_CTRL_SET_PARA_BY_ID, &val, sizeof(val)), PQCP_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyGen(deCtx), PQCP_SUCCESS);
+    uint32_t cipherLen = 0;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(deCtx, CRYPT_CTRL_GET_CIPHERTEXT_LEN, &cipherLen, sizeof(cipherLen)), PQCP_SUCCESS);
+    uint32_t ssLen = 0;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(deCtx, CRYPT_CTRL_GET_SHARED_KEY_LEN, &ssLen, sizeof(ssLen)), PQCP_SUCCESS);
+    ASSERT_TRUE(ssLen <= sizeof(sharedKey));
+    cipher = BSL_SAL_Malloc(cipherLen);
+    ASSERT_TRUE(cipher != NULL);
+    pubData = BSL_SAL_Malloc(37520 / 2);
+    ASSERT_TRUE(pubData != NULL);
+    BSL_Param pub[2] = {
+        {PQCP_PARAM_SCLOUDPLUS_PUBKEY, BSL_PARAM_TYPE_OCTETS, pubData, 37520 / 2, 0},
+        BSL_PARAM_END
+    };
+    ASSERT_EQ(CRYPT_EAL_PkeyGetPubEx(deCtx, pub), PQCP_SUCCESS);
+    pub[0].valueLen = pub[0].useLen;
+    ASSERT_EQ(CRYPT_EAL_PkeySetPubEx(enCtx, pub), PQCP_SUCCESS);
+
+    uint32_t fillNum = 1;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(enCtx, PQCP_SCLOUDPLUS_FILL_ENCAPS_POOL, &fillNum, sizeof(fillNum)),
+        PQCP_INVALID_ARG);
+    uint32_t poolCap = (uint32_t)capacity;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(enCtx, PQCP_SCLOUDPLUS_SET_ENCAPS_POOL, &poolCap, sizeof(poolCap)), PQCP_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(enCtx, PQCP_SCLOUDPLUS_FILL_ENCAPS_POOL, NULL, sizeof(fillNum)), PQCP_NULL_INPUT);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(enCtx, PQCP_SCLOUDPLUS_FILL_ENCAPS_POOL, &fillNum, sizeof(fillNum) - 1),
+        PQCP_NULL_INPUT);
+    uint32_t poolNum = 0;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(enCtx, PQCP_SCLOUDPLUS_GET_ENCAPS_POOL_NUM, &poolNum, sizeof(poolNum)), PQCP_SUCCESS);
+    ASSERT_EQ(poolNum, 0);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(enCtx, PQCP_SCLOUDPLUS_FILL_ENCAPS_POOL, &fillNum, sizeof(fillNum)), PQCP_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(enCtx, PQCP_SCLOUDPLUS_GET_ENCAPS_POOL_NUM, &poolNum, sizeof(poolNum)), PQCP_SUCCESS);
+    ASSERT_EQ(poolNum, 1);
+    fillNum = 0xFFFFFFFF;
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(enCtx, PQCP_SCLOUDPLUS_FILL_ENCAPS_POOL, &fillNum, sizeof(fillNum)), PQCP_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyCtrl(enCtx, PQCP_SCLOUDPLUS_GET_ENCAPS_POOL_NUM, &poolNum, sizeof(poolNum)), PQCP_SUCCESS);
+    ASSERT_EQ(poolNum, poolCap);
+
+    ASSERT_EQ(CRYPT_EAL_PkeyEncapsInit(enCtx, NULL), PQCP_SUCCESS);
+    ASSERT_EQ(CRYPT_EAL_PkeyDecapsInit(deCtx, NULL), PQCP_SUCCESS);
+    for (uint32_t i = 0; i <= poolCap; i++) {
+        uint32_t ctLen = cipherLen;
+        uint32_t encSsLen = ssLen;
+        ASSERT_EQ(CRYPT_EAL_PkeyEncaps(enCtx, cipher, &ctLen, sharedKey, &encSsLen), PQCP_SUCCESS);
+        ASSERT_EQ(CRYPT_EAL_PkeyCtrl(enCtx, PQCP_SCLOUDPLUS_GET_ENCAPS_POOL_NUM, &poolNum, sizeof(poolNum)),
+            PQCP_SUCCESS);
+        ASSERT_EQ(poolNum, (i < poolCap) ? (poolCap - i - 1) : 0);
+        uint32_t decSsLen = ssLen;
+        ASSERT_EQ(CRYPT_EAL_PkeyDecaps(deCtx, cipher, ctLen, decSharedKey, &decSsLen), PQCP_SUCCESS);
+        ASSERT_COMPARE("compare ss", sharedKey, encSsLen, decSharedKey, decSsLen);
+    }
+
+EXIT:
+    CRYPT_EAL_PkeyFreeCtx(enCtx);
+    CRYPT_EAL_PkeyFreeCtx(deCtx);
+    BSL_SAL_Free(cipher);
+    BSL_SAL_Free(pubData);
+    TestRandDeInit();
+    return;
+#else
+    SKIP_TEST();
+    (void)bits;
+    (void)capacity;
+#endif
+}
+/* END_CASE */
+
 /* @
 * @test  SDV_CRYPTO_PQCP_SCLOUDPLUS_VECTOR_TC001
 * @spec  -